@@ -0,0 +1,209 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <cstdlib>
+#include "VulkanEnums.hpp"
+
+//Compares the throughput of validateMany and toDenseIndexMany with calling isValid and toDenseIndex for every element.
+//The arrays hold random values of enums with few runs of consecutive values (checked with SIMD) and with many (searched per value).
+//Before timing an enum, checks that both return the same as the per-element functions, also for numbers that aren't values.
+//Exits with EXIT_FAILURE if they don't.
+//Usage: bulkBenchmark [--count 1000000] [--repetitions 10]
+
+using Clock = std::chrono::steady_clock;
+
+//Results are added to it so the compiler can't remove the loops
+static volatile uint64_t resultSink = 0;
+
+//Best time of all repetitions, in milliseconds
+template<typename Function>
+static double bestTime(unsigned int repetitionCount, Function&& function)
+{
+	double bestTime = std::numeric_limits<double>::max();
+	for (unsigned int i = 0; i < repetitionCount; ++i) {
+		Clock::time_point start = Clock::now();
+		function();
+		bestTime = std::min(bestTime, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+	}
+	return bestTime;
+}
+
+static void printRow(std::string_view enumName, std::string_view operation, size_t count, double perElementTime, double bulkTime)
+{
+	//Values per millisecond are thousands per second
+	auto megaValuesPerSecond = [count](double time) { return time > 0.0 ? count / time / 1000.0 : 0.0; };
+	std::cout << std::left << std::setw(28) << enumName << std::setw(18) << operation << std::right << std::setw(14)
+			  << megaValuesPerSecond(perElementTime) << std::setw(14) << megaValuesPerSecond(bulkTime) << std::setw(10)
+			  << (bulkTime > 0.0 ? perElementTime / bulkTime : 0.0) << "\n";
+}
+
+//Numbers around the values of Enum: values, their neighbours, which aren't values at the ends of runs, and arbitrary numbers
+template<typename Enum>
+static std::vector<int32_t> mixedNumbers(size_t count, std::mt19937& generator)
+{
+	std::uniform_int_distribution<size_t> indexDistribution(0, vk::kDenseCount<Enum> - 1);
+	std::uniform_int_distribution<int32_t> numberDistribution(std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max());
+	std::uniform_int_distribution<int> kindDistribution(0, 7);
+	std::vector<int32_t> numbers(count);
+	for (int32_t& number : numbers) {
+		int kind = kindDistribution(generator);
+		int64_t value = static_cast<int32_t>(vk::fromDenseIndex<Enum>(indexDistribution(generator)));
+		if (kind < 4) {
+			number = static_cast<int32_t>(value);
+		}
+		else if (kind < 6) {
+			int64_t neighbour = value + (kind == 4 ? -1 : 1);
+			number = static_cast<int32_t>(std::clamp<int64_t>(neighbour, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()));
+		}
+		else {
+			number = numberDistribution(generator);
+		}
+	}
+	return numbers;
+}
+
+//Checks validateMany and toDenseIndexMany on the first count numbers against isValid and toDenseIndex, for numbers and enum values
+template<typename Enum>
+static bool checkNumbers(std::string_view enumName, const int32_t* numbers, size_t count)
+{
+	bool expectedValid = true;
+	std::vector<Enum> values(count);
+	for (size_t i = 0; i < count; ++i) {
+		values[i] = static_cast<Enum>(numbers[i]);
+		expectedValid &= vk::isValid(values[i]);
+	}
+	std::vector<uint32_t> numberIndices(count + 1, ~0U);
+	std::vector<uint32_t> valueIndices(count + 1, ~0U);
+	bool isCorrect = vk::validateMany<Enum>(numbers, count) == expectedValid && vk::validateMany(values.data(), count) == expectedValid &&
+					 vk::toDenseIndexMany<Enum>(numbers, count, numberIndices.data()) == expectedValid &&
+					 vk::toDenseIndexMany(values.data(), count, valueIndices.data()) == expectedValid;
+	size_t firstWrongIndex = count;
+	for (size_t i = 0; i < count; ++i) {
+		uint32_t expectedIndex = static_cast<uint32_t>(vk::toDenseIndex(values[i]));
+		if (firstWrongIndex == count && (numberIndices[i] != expectedIndex || valueIndices[i] != expectedIndex)) firstWrongIndex = i;
+	}
+	//Nothing may be written past the end
+	isCorrect &= firstWrongIndex == count && numberIndices[count] == ~0U && valueIndices[count] == ~0U;
+	if (!isCorrect) {
+		std::cout << "Error: The bulk operations of " << enumName << " differ from isValid or toDenseIndex on " << count << " numbers";
+		if (firstWrongIndex < count) {
+			std::cout << ", the index of " << numbers[firstWrongIndex] << " at " << firstWrongIndex << " is " << numberIndices[firstWrongIndex] << " and "
+					  << valueIndices[firstWrongIndex] << " instead of " << vk::toDenseIndex(values[firstWrongIndex]);
+		}
+		std::cout << "\n";
+	}
+	return isCorrect;
+}
+
+//Compares the bulk operations with the per-element functions element by element. Arrays of every length up to 40 with a single
+//number that may not be a value at every position cover every SIMD lane and the scalar tail, a long mixed array the runs.
+template<typename Enum>
+static bool checkEnum(std::string_view enumName)
+{
+	std::mt19937 generator(2);
+	std::vector<int32_t> mixed = mixedNumbers<Enum>(4096, generator);
+	if (!checkNumbers<Enum>(enumName, mixed.data(), mixed.size())) return false;
+
+	std::uniform_int_distribution<size_t> indexDistribution(0, vk::kDenseCount<Enum> - 1);
+	std::vector<int32_t> numbers(40);
+	size_t mixedIndex = 0;
+	for (size_t count = 0; count <= numbers.size(); ++count) {
+		for (size_t position = 0; position <= count; ++position) {
+			for (int32_t& number : numbers) {
+				number = static_cast<int32_t>(vk::fromDenseIndex<Enum>(indexDistribution(generator)));
+			}
+			//position == count leaves all of them values
+			if (position < count) {
+				numbers[position] = mixed[mixedIndex++ % mixed.size()];
+			}
+			if (!checkNumbers<Enum>(enumName, numbers.data(), count)) return false;
+		}
+	}
+	return true;
+}
+
+template<typename Enum>
+static bool benchmarkEnum(std::string_view enumName, size_t count, unsigned int repetitionCount)
+{
+	//Values drawn uniformly from all values of the enum, like a valid file would contain
+	std::mt19937 generator(1);
+	if (!checkEnum<Enum>(enumName)) return false;
+
+	std::uniform_int_distribution<size_t> distribution(0, vk::kDenseCount<Enum> - 1);
+	std::vector<Enum> values(count);
+	for (Enum& value : values) {
+		value = vk::fromDenseIndex<Enum>(distribution(generator));
+	}
+	std::vector<uint32_t> indices(count);
+
+	double perElementValidation = bestTime(repetitionCount, [&]() {
+		bool allValid = true;
+		for (Enum value : values) allValid &= vk::isValid(value);
+		resultSink = resultSink + allValid;
+	});
+	double bulkValidation = bestTime(repetitionCount, [&]() { resultSink = resultSink + vk::validateMany(values.data(), values.size()); });
+	double perElementIndex = bestTime(repetitionCount, [&]() {
+		for (size_t i = 0; i < count; ++i) indices[i] = static_cast<uint32_t>(vk::toDenseIndex(values[i]));
+		resultSink = resultSink + indices.back();
+	});
+	double bulkIndex = bestTime(repetitionCount, [&]() {
+		resultSink = resultSink + vk::toDenseIndexMany(values.data(), values.size(), indices.data()) + indices.back();
+	});
+
+	std::string name = std::string(enumName) + " (" + std::to_string(vk::VulkanEnumsDetail::EnumRuns<Enum>::runCount) + " runs)";
+	printRow(name, "validate", count, perElementValidation, bulkValidation);
+	printRow(name, "toDenseIndex", count, perElementIndex, bulkIndex);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+#if defined(__VULKANENUMS_AVX2) && (defined(__GNUC__) || defined(__clang__))
+	if (!__builtin_cpu_supports("avx2")) {
+		std::cout << "Skipped: This build uses AVX2, which the CPU doesn't support\n";
+		return 77;
+	}
+#endif
+	size_t count = 1000000;
+	unsigned int repetitionCount = 10;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string_view argument = argv[i];
+		if (argument == "--count" && i + 1 < argc) {
+			count = static_cast<size_t>(std::max(1L, std::atol(argv[++i])));
+		}
+		else if (argument == "--repetitions" && i + 1 < argc) {
+			repetitionCount = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+		}
+		else {
+			std::cout << "Warning: Unrecognized argument " << argument << std::endl;
+		}
+	}
+
+#if defined(__VULKANENUMS_AVX2)
+	std::cout << "Bulk operations use AVX2";
+#elif defined(__VULKANENUMS_SSE2)
+	std::cout << "Bulk operations use SSE2";
+#else
+	std::cout << "Bulk operations are scalar";
+#endif
+	std::cout << ", enums with more than " << vk::VulkanEnumsDetail::maxVectorRunCount << " runs are searched per value\n";
+	std::cout << "Best of " << repetitionCount << " runs over " << count << " values, in millions of values per second\n";
+	std::cout << std::left << std::setw(28) << "enum" << std::setw(18) << "operation" << std::right << std::setw(14) << "per element"
+			  << std::setw(14) << "bulk" << std::setw(10) << "speedup" << "\n";
+	std::cout << std::fixed << std::setprecision(1);
+	bool isCorrect = benchmarkEnum<vk::Format>("Format", count, repetitionCount) &&
+					 benchmarkEnum<vk::BlendFactor>("BlendFactor", count, repetitionCount) &&
+					 benchmarkEnum<vk::PrimitiveTopology>("PrimitiveTopology", count, repetitionCount) &&
+					 benchmarkEnum<vk::StructureType>("StructureType", count, repetitionCount);
+	return isCorrect ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,166 @@
+#VulkanEnumClasses v1.0
+#https://github.com/pixelcluster/VulkanEnumClasses
+
+#Configures the benchmark project once per variant, times a clean build of each and summarizes the compiler's own timings.
+#Arguments (-D): VARIANTS (','-separated), INCLUDE_DIR, BINARY_DIR, GENERATOR, CXX_COMPILER, TU_COUNT
+string(REPLACE "," ";" VARIANTS "${VARIANTS}")
+
+#Microseconds since the epoch, %f is only supported from CMake 3.23 on
+function(currentTime outVariable)
+	if(CMAKE_VERSION VERSION_LESS 3.23)
+		string(TIMESTAMP seconds "%s" UTC)
+		set(${outVariable} "${seconds}000000" PARENT_SCOPE)
+	else()
+		string(TIMESTAMP microseconds "%s%f" UTC)
+		set(${outVariable} "${microseconds}" PARENT_SCOPE)
+	endif()
+endfunction()
+
+#Converts a decimal number of seconds (e.g. "0.25") to microseconds, math() only knows integers
+function(secondsToMicroseconds seconds outVariable)
+	string(REGEX MATCH "^([0-9]*)\\.?([0-9]*)$" unused "${seconds}")
+	set(integerPart "${CMAKE_MATCH_1}")
+	string(SUBSTRING "${CMAKE_MATCH_2}000000" 0 6 fractionPart)
+	string(REGEX REPLACE "^0+" "" integerPart "${integerPart}")
+	string(REGEX REPLACE "^0+" "" fractionPart "${fractionPart}")
+	if(integerPart STREQUAL "")
+		set(integerPart 0)
+	endif()
+	if(fractionPart STREQUAL "")
+		set(fractionPart 0)
+	endif()
+	math(EXPR microseconds "${integerPart} * 1000000 + ${fractionPart}")
+	set(${outVariable} "${microseconds}" PARENT_SCOPE)
+endfunction()
+
+#Sums the CPU times (user + system) of all lines of the GCC -ftime-report tables in output whose name matches itemName.
+#The wall time column also counts waiting for other compilers running in parallel.
+function(sumTimeReport output itemName outVariable)
+	set(total 0)
+	string(REGEX MATCHALL " ${itemName} +:[^\n]*" lines "${output}")
+	foreach(line IN LISTS lines)
+		if(line MATCHES ":[ ]*([0-9.]+) \\([ 0-9]+%\\)[ ]*([0-9.]+) \\([ 0-9]+%\\)")
+			set(systemSeconds "${CMAKE_MATCH_2}")
+			secondsToMicroseconds("${CMAKE_MATCH_1}" userTime)
+			secondsToMicroseconds("${systemSeconds}" systemTime)
+			math(EXPR total "${total} + ${userTime} + ${systemTime}")
+		endif()
+	endforeach()
+	set(${outVariable} "${total}" PARENT_SCOPE)
+endfunction()
+
+#Sums the duration and count of the "Total <eventName>" events of all clang -ftime-trace files
+function(sumTimeTrace traceFiles eventName outDuration outCount)
+	set(duration 0)
+	set(count 0)
+	foreach(traceFile IN LISTS traceFiles)
+		file(READ "${traceFile}" trace)
+		if(trace MATCHES "\"dur\":([0-9]+),\"name\":\"Total ${eventName}\",\"args\":{\"count\":([0-9]+)")
+			math(EXPR duration "${duration} + ${CMAKE_MATCH_1}")
+			math(EXPR count "${count} + ${CMAKE_MATCH_2}")
+		endif()
+	endforeach()
+	set(${outDuration} "${duration}" PARENT_SCOPE)
+	set(${outCount} "${count}" PARENT_SCOPE)
+endfunction()
+
+#Generated files a translation unit of variant parses. Split output turns VulkanEnums.hpp into an umbrella header.
+function(variantHeaders variant outVariable)
+	if(variant STREQUAL "split")
+		set(headers "${INCLUDE_DIR}/VulkanEnums/VK_VERSION_1_0.hpp")
+	elseif(variant STREQUAL "fwd")
+		set(headers "${INCLUDE_DIR}/VulkanEnumsFwd.hpp")
+	elseif(variant STREQUAL "module")
+		set(headers "${INCLUDE_DIR}/VulkanEnums.cppm")
+	else()
+		set(headers "${INCLUDE_DIR}/VulkanEnums.hpp")
+		list(FIND VARIANTS "split" splitIndex)
+		if(NOT splitIndex EQUAL -1)
+			file(GLOB splitHeaders "${INCLUDE_DIR}/VulkanEnums/*.hpp")
+			list(APPEND headers ${splitHeaders})
+		endif()
+	endif()
+	set(${outVariable} "${headers}" PARENT_SCOPE)
+endfunction()
+
+function(formatMilliseconds microseconds outVariable)
+	math(EXPR milliseconds "${microseconds} / 1000")
+	math(EXPR fraction "(${microseconds} % 1000) / 10")
+	if(fraction LESS 10)
+		set(fraction "0${fraction}")
+	endif()
+	set(${outVariable} "${milliseconds}.${fraction}" PARENT_SCOPE)
+endfunction()
+
+foreach(variant IN LISTS VARIANTS)
+	set(variantDir "${BINARY_DIR}/${variant}")
+	execute_process(COMMAND "${CMAKE_COMMAND}" -S "${CMAKE_CURRENT_LIST_DIR}" -B "${variantDir}" -G "${GENERATOR}"
+		"-DCMAKE_CXX_COMPILER=${CXX_COMPILER}" -DCMAKE_BUILD_TYPE=Release "-DVARIANT=${variant}"
+		"-DINCLUDE_DIR=${INCLUDE_DIR}" "-DTU_COUNT=${TU_COUNT}"
+		RESULT_VARIABLE result OUTPUT_QUIET)
+	if(NOT result EQUAL 0)
+		message(WARNING "Configuring the ${variant} compile benchmark failed")
+		continue()
+	endif()
+	execute_process(COMMAND "${CMAKE_COMMAND}" --build "${variantDir}" --target clean OUTPUT_QUIET)
+	file(GLOB_RECURSE staleTraces "${variantDir}/CMakeFiles/CompileBenchmark.dir/*.json")
+	if(staleTraces)
+		file(REMOVE ${staleTraces})
+	endif()
+
+	currentTime(startTime)
+	execute_process(COMMAND "${CMAKE_COMMAND}" --build "${variantDir}" --parallel RESULT_VARIABLE result OUTPUT_VARIABLE buildOutput ERROR_VARIABLE buildOutput)
+	currentTime(endTime)
+	if(NOT result EQUAL 0)
+		message(WARNING "Building the ${variant} compile benchmark failed")
+		continue()
+	endif()
+
+	math(EXPR milliseconds "(${endTime} - ${startTime}) / 1000")
+	message(STATUS "${variant}: ${milliseconds} ms for ${TU_COUNT} translation units")
+
+	#Size of the generated code every translation unit parses, per enum it gets
+	variantHeaders("${variant}" headers)
+	set(headerBytes 0)
+	set(enumCount 0)
+	foreach(header IN LISTS headers)
+		if(EXISTS "${header}")
+			file(SIZE "${header}" size)
+			file(STRINGS "${header}" enumLines REGEX "enum class ")
+			list(LENGTH enumLines lineCount)
+			math(EXPR headerBytes "${headerBytes} + ${size}")
+			math(EXPR enumCount "${enumCount} + ${lineCount}")
+		endif()
+	endforeach()
+	if(enumCount GREATER 0)
+		math(EXPR bytesPerEnum "${headerBytes} / ${enumCount}")
+		message(STATUS "  ${headerBytes} bytes of generated code, ${enumCount} enums, ${bytesPerEnum} bytes per enum")
+	endif()
+
+	#The compiler's own view, averaged over all translation units
+	file(GLOB_RECURSE traceFiles "${variantDir}/CMakeFiles/CompileBenchmark.dir/*.json")
+	if(traceFiles)
+		sumTimeTrace("${traceFiles}" "Frontend" frontendTime frontendCount)
+		sumTimeTrace("${traceFiles}" "Source" sourceTime sourceCount)
+		sumTimeTrace("${traceFiles}" "InstantiateClass" classTime classCount)
+		sumTimeTrace("${traceFiles}" "InstantiateFunction" functionTime functionCount)
+		math(EXPR frontendTime "${frontendTime} / ${TU_COUNT}")
+		math(EXPR sourceTime "${sourceTime} / ${TU_COUNT}")
+		math(EXPR instantiationTime "(${classTime} + ${functionTime}) / ${TU_COUNT}")
+		math(EXPR instantiationCount "(${classCount} + ${functionCount}) / ${TU_COUNT}")
+		formatMilliseconds(${frontendTime} frontendTime)
+		formatMilliseconds(${sourceTime} sourceTime)
+		formatMilliseconds(${instantiationTime} instantiationTime)
+		message(STATUS "  per translation unit: frontend ${frontendTime} ms, parsing sources ${sourceTime} ms, "
+			"${instantiationCount} template instantiations in ${instantiationTime} ms (-ftime-trace)")
+	elseif(buildOutput MATCHES "phase parsing")
+		sumTimeReport("${buildOutput}" "phase parsing" parsingTime)
+		sumTimeReport("${buildOutput}" "phase lang. deferred" deferredTime)
+		sumTimeReport("${buildOutput}" "template instantiation" instantiationTime)
+		math(EXPR frontendTime "(${parsingTime} + ${deferredTime}) / ${TU_COUNT}")
+		math(EXPR instantiationTime "${instantiationTime} / ${TU_COUNT}")
+		formatMilliseconds(${frontendTime} frontendTime)
+		formatMilliseconds(${instantiationTime} instantiationTime)
+		message(STATUS "  per translation unit: frontend ${frontendTime} ms, template instantiation ${instantiationTime} ms of CPU time (-ftime-report)")
+	endif()
+endforeach()
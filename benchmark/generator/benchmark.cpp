@@ -0,0 +1,193 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include "generate.hpp"
+#include "synthetic_registry.hpp"
+
+//Times every phase of the generator on synthetic registries of increasing size.
+//The last column divides the growth of the time by the growth of the registry: values well above 1 point to superlinear behaviour.
+//Usage: generatorBenchmark [--scales 1,10,100] [--repetitions 5] [--no-dom]
+
+using Clock = std::chrono::steady_clock;
+
+static double millisecondsSince(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+//Best time per phase over all repetitions, in milliseconds
+struct PhaseTimes
+{
+	std::vector<std::string> names;
+	std::vector<double> times;
+
+	void record(size_t phaseIndex, std::string_view name, double time) {
+		if (phaseIndex == names.size()) {
+			names.emplace_back(name);
+			times.push_back(time);
+		}
+		else {
+			times[phaseIndex] = std::min(times[phaseIndex], time);
+		}
+	}
+};
+
+//All options that transform names, so the processing functions do their full work
+static ParsingOptions benchmarkOptions()
+{
+	ParsingOptions options;
+	options.replaceNames = true;
+	options.replaceValues = true;
+	options.numberPrefix = "_";
+	options.removeUnderscores = true;
+	options.removeStructureNames = true;
+	options.valueToLower = true;
+	options.valueCapitalizeStart = true;
+	options.valueRemovePostfix = true;
+	options.nameRemovePostfix = true;
+	return options;
+}
+
+static void runRepetition(const std::string& path, const SyntheticRegistryInfo& info, bool measureDocument, PhaseTimes& phaseTimes)
+{
+	size_t phaseIndex = 0;
+	auto measure = [&](std::string_view name, auto&& function) {
+		Clock::time_point start = Clock::now();
+		function();
+		phaseTimes.record(phaseIndex++, name, millisecondsSince(start));
+	};
+
+	if (measureDocument) {
+		measure("load (tinyxml2)", [&]() {
+			tinyxml2::XMLDocument document;
+			Registry documentRegistry;
+			document.LoadFile(path.c_str());
+			if (document.Error() || !readRegistryDocument(document, documentRegistry)) {
+				std::cout << "Error: Unable to read " << path << " with tinyxml2\n";
+			}
+		});
+	}
+
+	Registry registry;
+	measure("load (streaming)", [&]() {
+		if (!loadRegistry(path, registry)) {
+			std::cout << "Error: Unable to read " << path << "\n";
+		}
+	});
+
+	ParsingOptions options = benchmarkOptions();
+	options.extensionTagNames.assign(registry.tags.begin(), registry.tags.end());
+
+	EnumMap enums = EnumMap(registry.symbols);
+	measure("parseBasicEnums", [&]() { enums = parseBasicEnums(registry); });
+	measure("includeFeatureEnums", [&]() { includeFeatureEnums(registry, enums); });
+	measure("includeExtensionEnums", [&]() { includeExtensionEnums(registry, options, enums); });
+	measure("transformNames", [&]() { transformNames(enums, options); });
+	measure("writeEnums", [&]() {
+		CodeWriter writer;
+		writeEnums(enums, writer, options);
+	});
+
+	ExtensionGraph graph = ExtensionGraph(registry.symbols);
+	measure("buildExtensionGraph", [&]() { graph = buildExtensionGraph(registry); });
+
+	//Long lists: every extension is included explicitly, every fourth one is excluded
+	std::vector<std::string> extensionNames;
+	for (size_t i = 0; i < info.extensionCount; ++i) {
+		extensionNames.push_back(syntheticExtensionName(i));
+	}
+	measure("includeExtensionDependencies", [&]() {
+		std::vector<bool> includedExtensions = std::vector<bool>(graph.size(), false);
+		for (auto& name : extensionNames) {
+			includeExtensionDependencies(graph, name, includedExtensions);
+		}
+	});
+	measure("excludeDependentExtensions", [&]() {
+		std::vector<bool> includedExtensions = std::vector<bool>(graph.size(), true);
+		for (size_t i = 0; i < extensionNames.size(); i += 4) {
+			excludeDependentExtensions(graph, extensionNames[i], includedExtensions);
+		}
+	});
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<unsigned int> scales = { 1, 10, 100 };
+	unsigned int repetitionCount = 5;
+	bool measureDocument = true;
+
+	for (int i = 1; i < argc; ++i) {
+		std::string_view argument = argv[i];
+		if (argument == "--scales" && i + 1 < argc) {
+			scales.clear();
+			for (auto& scale : splitList(argv[++i], ',')) {
+				scales.push_back(static_cast<unsigned int>(std::atoi(scale.c_str())));
+			}
+		}
+		else if (argument == "--repetitions" && i + 1 < argc) {
+			repetitionCount = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+		}
+		else if (argument == "--no-dom") {
+			measureDocument = false;
+		}
+		else {
+			std::cout << "Warning: Unrecognized argument " << argument << std::endl;
+		}
+	}
+	scales.erase(std::remove(scales.begin(), scales.end(), 0u), scales.end());
+	if (scales.empty()) {
+		std::cout << "Error: No valid scales given\n";
+		return EXIT_FAILURE;
+	}
+
+	std::vector<PhaseTimes> scaleTimes;
+	for (unsigned int scale : scales) {
+		SyntheticRegistryInfo info;
+		std::string xml = buildSyntheticRegistry(scale, info);
+		std::string path = "synthetic_vk_" + std::to_string(scale) + "x.xml";
+		{
+			std::ofstream file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+			file.write(xml.data(), static_cast<std::streamsize>(xml.size()));
+			if (!file.good()) {
+				std::cout << "Error: Unable to write " << path << "\n";
+				return EXIT_FAILURE;
+			}
+		}
+		std::cout << path << ": " << xml.size() / 1024 << " KiB, " << info.enumCount << " enums, " << info.valueCount << " values, "
+				  << info.extensionCount << " extensions\n";
+
+		PhaseTimes& phaseTimes = scaleTimes.emplace_back();
+		for (unsigned int i = 0; i < repetitionCount; ++i) {
+			runRepetition(path, info, measureDocument, phaseTimes);
+		}
+	}
+
+	std::cout << "\nBest of " << repetitionCount << " runs, in milliseconds\n";
+	std::cout << std::left << std::setw(30) << "phase" << std::right;
+	for (unsigned int scale : scales) {
+		std::cout << std::setw(12) << (std::to_string(scale) + "x");
+	}
+	std::cout << std::setw(12) << "growth" << "\n";
+
+	std::cout << std::fixed << std::setprecision(3);
+	const PhaseTimes& firstTimes = scaleTimes.front();
+	const PhaseTimes& lastTimes = scaleTimes.back();
+	double scaleGrowth = static_cast<double>(scales.back()) / scales.front();
+	for (size_t phase = 0; phase < firstTimes.names.size(); ++phase) {
+		std::cout << std::left << std::setw(30) << firstTimes.names[phase] << std::right;
+		for (auto& phaseTimes : scaleTimes) {
+			std::cout << std::setw(12) << phaseTimes.times[phase];
+		}
+		if (scales.size() > 1 && firstTimes.times[phase] > 0.0) {
+			std::cout << std::setw(12) << lastTimes.times[phase] / firstTimes.times[phase] / scaleGrowth;
+		}
+		std::cout << "\n";
+	}
+}
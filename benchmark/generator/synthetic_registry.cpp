@@ -0,0 +1,269 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#include "synthetic_registry.hpp"
+#include <vector>
+
+namespace {
+
+//Counts of the real vk.xml (1.3.2xx), rounded
+constexpr size_t coreEnumsPerScale = 180;
+constexpr size_t extensionEnumsPerScale = 140;
+constexpr size_t extensionsPerScale = 450;
+constexpr size_t featureCount = 6;
+constexpr size_t tagCount = 60;
+constexpr size_t commandsPerScale = 600;
+
+//xorshift, fixed seed so every run benchmarks the same document
+class Random
+{
+public:
+	uint32_t next() {
+		m_state ^= m_state << 13;
+		m_state ^= m_state >> 7;
+		m_state ^= m_state << 17;
+		return static_cast<uint32_t>(m_state >> 32);
+	}
+	uint32_t below(uint32_t limit) { return next() % limit; }
+private:
+	uint64_t m_state = 0x9E3779B97F4A7C15ULL;
+};
+
+enum class SyntheticEnumType {
+	Enum, Bitmask, Bitmask64
+};
+
+struct SyntheticEnum
+{
+	//Name without the "Vk" prefix, e.g. "Synth12FlagBits"
+	std::string name;
+	//Value prefix, e.g. "VK_SYNTH12_"
+	std::string valuePrefix;
+	std::string valuePostfix;
+	SyntheticEnumType type;
+	size_t valueCount;
+};
+
+std::string tagName(size_t tagIndex) {
+	//The first tags are the common ones, the rest are made up
+	static const char* commonTags[] = { "KHR", "EXT", "NV", "AMD", "INTEL", "ARM", "QCOM", "HUAWEI" };
+	if (tagIndex < sizeof(commonTags) / sizeof(commonTags[0])) return commonTags[tagIndex];
+	std::string name = "X";
+	for (size_t remaining = tagIndex; remaining; remaining /= 26) {
+		name.push_back(static_cast<char>('A' + remaining % 26));
+	}
+	return name;
+}
+
+std::string versionName(size_t featureIndex) {
+	return "VK_VERSION_1_" + std::to_string(featureIndex);
+}
+
+void appendValue(std::string& xml, const SyntheticEnum& syntheticEnum, size_t valueIndex, Random& random) {
+	std::string valueName = syntheticEnum.valuePrefix + "VALUE" + std::to_string(valueIndex);
+	xml += "        <enum ";
+	switch (syntheticEnum.type) {
+	case SyntheticEnumType::Enum:
+		xml += "value=\"" + std::to_string(valueIndex) + "\"";
+		break;
+	case SyntheticEnumType::Bitmask:
+		xml += "bitpos=\"" + std::to_string(valueIndex % 31) + "\"";
+		valueName += "_BIT";
+		break;
+	case SyntheticEnumType::Bitmask64:
+		xml += "bitpos=\"" + std::to_string(valueIndex % 63) + "\"";
+		valueName += "_BIT";
+		break;
+	}
+	xml += " name=\"" + valueName + syntheticEnum.valuePostfix + "\"";
+	if (random.below(4) == 0) {
+		xml += " comment=\"Synthetic value " + std::to_string(valueIndex) + " &amp; its description\"";
+	}
+	xml += "/>\n";
+}
+
+}
+
+std::string syntheticExtensionName(size_t extensionIndex) {
+	return "VK_" + tagName(extensionIndex % tagCount) + "_synthetic_extension_" + std::to_string(extensionIndex);
+}
+
+std::string buildSyntheticRegistry(unsigned int scale, SyntheticRegistryInfo& info) {
+	Random random;
+	std::string xml;
+	xml.reserve(scale * 2500000);
+	xml += "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<registry>\n    <comment>\nSynthetic registry for benchmarking, scale " + std::to_string(scale) + "\n    </comment>\n";
+
+	xml += "    <tags comment=\"Vulkan vendor/author tags for extensions and layers\">\n";
+	for (size_t i = 0; i < tagCount; ++i) {
+		xml += "        <tag name=\"" + tagName(i) + "\" author=\"Synthetic\" contact=\"Nobody @nobody\"/>\n";
+	}
+	xml += "    </tags>\n";
+
+	size_t coreEnumCount = coreEnumsPerScale * scale;
+	size_t extensionEnumCount = extensionEnumsPerScale * scale;
+	size_t extensionCount = extensionsPerScale * scale;
+
+	//Core enums first, then the enums introduced by extensions
+	std::vector<SyntheticEnum> enums;
+	enums.reserve(coreEnumCount + extensionEnumCount);
+	for (size_t i = 0; i < coreEnumCount + extensionEnumCount; ++i) {
+		SyntheticEnum syntheticEnum;
+		std::string number = std::to_string(i);
+		syntheticEnum.valuePrefix = "VK_SYNTH" + number + "_";
+		//Enums introduced by extensions carry a vendor tag like in vk.xml
+		std::string tag;
+		if (i >= coreEnumCount) {
+			tag = tagName((i - coreEnumCount) * extensionCount / extensionEnumCount % tagCount);
+			syntheticEnum.valuePostfix = "_" + tag;
+		}
+		uint32_t kind = random.below(16);
+		if (kind < 10) {
+			syntheticEnum.type = SyntheticEnumType::Enum;
+			syntheticEnum.name = "Synth" + number + tag;
+		}
+		else if (kind < 15) {
+			syntheticEnum.type = SyntheticEnumType::Bitmask;
+			syntheticEnum.name = "Synth" + number + "FlagBits" + tag;
+		}
+		else {
+			syntheticEnum.type = SyntheticEnumType::Bitmask64;
+			syntheticEnum.name = "Synth" + number + "FlagBits2" + tag;
+		}
+		syntheticEnum.valueCount = 2 + random.below(20);
+		enums.push_back(std::move(syntheticEnum));
+	}
+
+	xml += "    <types comment=\"Vulkan type definitions\">\n";
+	for (auto& syntheticEnum : enums) {
+		xml += "        <type name=\"Vk" + syntheticEnum.name + "\" category=\"enum\"/>\n";
+		xml += "        <type category=\"struct\" name=\"Vk" + syntheticEnum.name + "Info\">\n";
+		xml += "            <member><type>VkStructureType</type> <name>sType</name></member>\n";
+		xml += "            <member><type>Vk" + syntheticEnum.name + "</type> <name>value</name></member>\n";
+		xml += "        </type>\n";
+	}
+	xml += "    </types>\n";
+
+	xml += "    <enums name=\"API Constants\" comment=\"Vulkan hardcoded constants - not an enumerated type, part of the header boilerplate\">\n";
+	xml += "        <enum type=\"uint32_t\" value=\"256\" name=\"VK_MAX_PHYSICAL_DEVICE_NAME_SIZE\"/>\n";
+	xml += "    </enums>\n";
+
+	for (auto& syntheticEnum : enums) {
+		xml += "    <enums name=\"Vk" + syntheticEnum.name + "\"";
+		xml += syntheticEnum.type == SyntheticEnumType::Enum ? " type=\"enum\"" : " type=\"bitmask\"";
+		if (syntheticEnum.type == SyntheticEnumType::Bitmask64) xml += " bitwidth=\"64\"";
+		xml += ">\n";
+		for (size_t j = 0; j < syntheticEnum.valueCount; ++j) {
+			appendValue(xml, syntheticEnum, j, random);
+		}
+		info.valueCount += syntheticEnum.valueCount;
+		if (random.below(4) == 0) {
+			xml += "        <enum name=\"" + syntheticEnum.valuePrefix + "ALIAS" + syntheticEnum.valuePostfix + "\" alias=\"" + syntheticEnum.valuePrefix + "VALUE0" +
+				   (syntheticEnum.type == SyntheticEnumType::Enum ? "" : "_BIT") + syntheticEnum.valuePostfix + "\"/>\n";
+			++info.valueCount;
+		}
+		xml += "    </enums>\n";
+	}
+
+	xml += "    <commands comment=\"Vulkan command definitions\">\n";
+	for (size_t i = 0; i < commandsPerScale * scale; ++i) {
+		xml += "        <command successcodes=\"VK_SUCCESS\" errorcodes=\"VK_ERROR_OUT_OF_HOST_MEMORY\">\n";
+		xml += "            <proto><type>VkResult</type> <name>vkSynthCommand" + std::to_string(i) + "</name></proto>\n";
+		xml += "            <param><type>VkDevice</type> <name>device</name></param>\n";
+		xml += "        </command>\n";
+	}
+	xml += "    </commands>\n";
+
+	//Features require the core enums in equal shares and add values to earlier enums
+	for (size_t feature = 0; feature < featureCount; ++feature) {
+		xml += "    <feature api=\"vulkan\" name=\"" + versionName(feature) + "\" number=\"1." + std::to_string(feature) + "\">\n";
+		xml += "        <require>\n";
+		for (size_t i = feature * coreEnumCount / featureCount; i < (feature + 1) * coreEnumCount / featureCount; ++i) {
+			xml += "            <type name=\"Vk" + enums[i].name + "\"/>\n";
+		}
+		if (feature > 0) {
+			for (size_t i = 0; i < 20 * scale; ++i) {
+				const SyntheticEnum& extendedEnum = enums[random.below(static_cast<uint32_t>(feature * coreEnumCount / featureCount))];
+				std::string valueName = extendedEnum.valuePrefix + "FEATURE" + std::to_string(feature) + "_VALUE" + std::to_string(i);
+				if (extendedEnum.type == SyntheticEnumType::Enum) {
+					xml += "            <enum extends=\"Vk" + extendedEnum.name + "\" value=\"" + std::to_string(100 + i) + "\" name=\"" + valueName + "\"/>\n";
+				}
+				else {
+					xml += "            <enum extends=\"Vk" + extendedEnum.name + "\" bitpos=\"" + std::to_string(i % 31) + "\" name=\"" + valueName + "_BIT\"/>\n";
+				}
+				++info.valueCount;
+			}
+		}
+		xml += "        </require>\n";
+		xml += "    </feature>\n";
+	}
+
+	//Like VKSC_VERSION_1_0 in vk.xml, a Vulkan SC feature adds values that vulkan_core.h doesn't declare
+	xml += "    <feature api=\"vulkansc\" name=\"VKSC_VERSION_1_0\" number=\"1.0\">\n";
+	xml += "        <require>\n";
+	size_t scValueCount = 0;
+	for (size_t i = 0; i < coreEnumCount && scValueCount < 4 * scale; ++i) {
+		if (enums[i].type != SyntheticEnumType::Enum) continue;
+		xml += "            <enum offset=\"0\" extends=\"Vk" + enums[i].name + "\" extnumber=\"" + std::to_string(extensionCount + 1) +
+			   "\" dir=\"-\" name=\"" + enums[i].valuePrefix + "SC_VALUE\"/>\n";
+		++scValueCount;
+		++info.valueCount;
+	}
+	xml += "        </require>\n";
+	xml += "    </feature>\n";
+
+	//Extensions depend on earlier ones, introduce the extension enums and extend core enums
+	xml += "    <extensions comment=\"Vulkan extension interface definitions\">\n";
+	for (size_t i = 0; i < extensionCount; ++i) {
+		std::string name = syntheticExtensionName(i);
+		std::string tag = tagName(i % tagCount);
+		xml += "        <extension name=\"" + name + "\" number=\"" + std::to_string(i + 1) + "\" type=\"device\"";
+		if (i > 0) {
+			std::string dependency = syntheticExtensionName(random.below(static_cast<uint32_t>(i)));
+			switch (random.below(5)) {
+			case 0:
+				break;
+			case 1:
+			case 2:
+				xml += " depends=\"" + dependency + "\"";
+				break;
+			case 3:
+				xml += " depends=\"" + dependency + "+" + syntheticExtensionName(random.below(static_cast<uint32_t>(i))) + "\"";
+				break;
+			case 4:
+				xml += " depends=\"(" + dependency + "+" + syntheticExtensionName(random.below(static_cast<uint32_t>(i))) + ")," + versionName(1 + random.below(featureCount - 1)) + "\"";
+				break;
+			}
+		}
+		if (random.below(10) == 0) {
+			xml += " promotedto=\"" + versionName(1 + random.below(featureCount - 1)) + "\"";
+		}
+		xml += " supported=\"vulkan\">\n";
+		xml += "            <require>\n";
+		xml += "                <enum value=\"1\" name=\"" + name.substr(0, 3) + "SYNTHETIC_EXTENSION_" + std::to_string(i) + "_SPEC_VERSION\"/>\n";
+		for (size_t j = i * extensionEnumCount / extensionCount; j < (i + 1) * extensionEnumCount / extensionCount; ++j) {
+			xml += "                <type name=\"Vk" + enums[coreEnumCount + j].name + "\"/>\n";
+		}
+		size_t additionCount = random.below(5);
+		for (size_t j = 0; j < additionCount; ++j) {
+			const SyntheticEnum& extendedEnum = enums[random.below(static_cast<uint32_t>(coreEnumCount))];
+			std::string valueName = extendedEnum.valuePrefix + "EXTENSION" + std::to_string(i) + "_VALUE" + std::to_string(j);
+			if (extendedEnum.type == SyntheticEnumType::Enum) {
+				xml += "                <enum offset=\"" + std::to_string(j) + "\"" + (random.below(8) == 0 ? " dir=\"-\"" : "") +
+					   " extends=\"Vk" + extendedEnum.name + "\" name=\"" + valueName + "_" + tag + "\"/>\n";
+			}
+			else {
+				xml += "                <enum bitpos=\"" + std::to_string(random.below(31)) + "\" extends=\"Vk" + extendedEnum.name + "\" name=\"" + valueName + "_BIT_" + tag + "\"/>\n";
+			}
+			++info.valueCount;
+		}
+		xml += "            </require>\n";
+		xml += "        </extension>\n";
+	}
+	xml += "    </extensions>\n";
+	xml += "</registry>\n";
+
+	info.enumCount = enums.size();
+	info.extensionCount = extensionCount;
+	return xml;
+}
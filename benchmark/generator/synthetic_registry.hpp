@@ -0,0 +1,24 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#pragma once
+#include <string>
+#include <cstdint>
+
+//Deterministic vk.xml-shaped registries for benchmarking.
+//At scale 1 the enum, value, feature and extension counts roughly match the real vk.xml.
+//The documents use all constructs the generator handles: basic, bitmask and 64-bit bitmask enums, aliases, comments,
+//feature and extension additions (value, bitpos and offset), "depends" expressions and promoted extensions.
+//Sections the generator skips (<types>, <commands>) are included so skipping them is measured as well.
+
+struct SyntheticRegistryInfo
+{
+	size_t enumCount = 0;
+	size_t valueCount = 0;
+	size_t extensionCount = 0;
+};
+
+//Returns the XML text of a registry scale times the size of vk.xml. The same scale always produces the same text.
+std::string buildSyntheticRegistry(unsigned int scale, SyntheticRegistryInfo& info);
+//Name of the extension with the given index in a synthetic registry
+std::string syntheticExtensionName(size_t extensionIndex);
@@ -0,0 +1,18 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#pragma once
+#include <cstdint>
+
+//Process-wide allocation counters, maintained by the global operator new/delete replacements in allocation_stats.cpp.
+
+struct AllocationStats
+{
+	uint64_t allocationCount = 0;
+	uint64_t allocatedBytes = 0;
+};
+
+//Counts of all operator new calls since program start
+AllocationStats currentAllocationStats();
+//Peak resident set size of the process in bytes, 0 if unknown
+uint64_t peakResidentSetSize();
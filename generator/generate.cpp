@@ -3,232 +3,2079 @@
 
 #include "generate.hpp"
 #include "parsing_utils.hpp"
+#include "parallel.hpp"
 #include <iostream>
+#include <charconv>
+#include <cctype>
+#include <iterator>
+#include <algorithm>
+#include <unordered_set>
 
 using namespace tinyxml2;
-//defined for parsing_utils.hpp
-unsigned int indentationLevel = 0;
 
 void generateFromDocument(const XMLDocument& document, ParsingOptions& options, std::ostream& outStream)
 {
-	const XMLElement* registry = document.FirstChildElement("registry");
-	if (!registry) {
+	Registry registry;
+	if (!readRegistryDocument(document, registry)) {
 		std::cout << "Error: Unable to find registry root node, is vk.xml valid?\n";
 		return;
 	}
+	generateFromRegistry(registry, options, outStream);
+}
 
+//Runs all parsing phases, the resulting enums reference registry. Phase times and counts go to stats if it isn't null.
+static EnumMap parseRegistry(const Registry& registry, ParsingOptions& options, GenerationStats* stats)
+{
 	//Find extension tags if they need to be removed
 	if (options.nameRemovePostfix || options.valueRemovePostfix || options.valueToLower) {
-		const XMLElement* tagsElement = registry->FirstChildElement("tags");
-		if (tagsElement) {
-			const XMLElement* tag = tagsElement->FirstChildElement("tag");
-			while (tag)
-			{
-				const char* tagName = tag->Attribute("name");
-				if (tagName) options.extensionTagNames.push_back(tagName);
-				tag = tag->NextSiblingElement("tag");
-			}
-		}
+		options.extensionTagNames.assign(registry.tags.begin(), registry.tags.end());
 		if (options.extensionTagNames.empty()) {
 			std::cout << "No extension tags found. Generation might not work flawlessly\n";
 		}
 	}
 
-	EnumMap enums = parseBasicEnums(registry, options);
-	includeFeatureEnums(registry, options, enums);
-	includeExtensionEnums(registry, options, enums);
-	writeEnums(enums, outStream, options);
+	EnumMap enums = EnumMap(registry.symbols);
+	size_t includedExtensionCount;
+	{
+		PhaseTimer timer = PhaseTimer(stats, "basicEnums");
+		enums = parseBasicEnums(registry);
+	}
+	{
+		PhaseTimer timer = PhaseTimer(stats, "features");
+		includeFeatureEnums(registry, enums);
+	}
+	{
+		PhaseTimer timer = PhaseTimer(stats, "extensions");
+		includedExtensionCount = includeExtensionEnums(registry, options, enums);
+	}
+	{
+		PhaseTimer timer = PhaseTimer(stats, "transforms");
+		transformNames(enums, options);
+	}
+
+	if (stats) {
+		GenerationCounts& counts = stats->counts;
+		counts.enums = enums.size();
+		for (auto& vulkanEnum : enums) {
+			if (!vulkanEnum.isIncluded) continue;
+			++counts.includedEnums;
+			counts.values += vulkanEnum.values().size();
+			counts.aliases += vulkanEnum.aliasValues().size();
+		}
+		counts.includedExtensions = includedExtensionCount;
+		counts.excludedExtensions = registry.extensions.size() - includedExtensionCount;
+	}
+	return enums;
+}
+
+void generateFromRegistry(const Registry& registry, ParsingOptions& options, std::ostream& outStream, unsigned int jobCount)
+{
+	EnumMap enums = parseRegistry(registry, options, nullptr);
+
+	CodeWriter writer;
+	writeEnums(enums, writer, options, jobCount);
+	writer.writeTo(outStream);
 }
 
-EnumMap parseBasicEnums(const XMLElement* registry, const ParsingOptions& options)
+std::vector<GeneratedFile> generateFilesFromRegistry(const Registry& registry, ParsingOptions& options, unsigned int jobCount, GenerationStats* stats)
 {
-	EnumMap enumMap;
+	EnumMap enums = parseRegistry(registry, options, stats);
 
-	const XMLElement* enumsNode = registry->FirstChildElement("enums");
-	if (!enumsNode) {
-		std::cout << "Error: Unable to find enums nodes, is vk.xml valid?\n";
-		return enumMap;
+	PhaseTimer timer = PhaseTimer(stats, "write");
+	std::vector<GeneratedFile> files;
+	if (options.splitOutput) {
+		files = writeSplitEnums(registry, enums, options, jobCount);
 	}
-	if (enumsNode->Attribute("name") && !strcmp(enumsNode->Attribute("name"), "API Constants")) {
-		enumsNode = enumsNode->NextSiblingElement("enums");
+	else {
+		GeneratedFile& headerFile = files.emplace_back();
+		headerFile.path = "VulkanEnums.hpp";
+		writeEnums(enums, headerFile.contents, options, jobCount);
+	}
+
+	if (options.moduleOutput) {
+		GeneratedFile& moduleFile = files.emplace_back();
+		moduleFile.path = "VulkanEnums.cppm";
+		writeModule(enums, moduleFile.contents, options, jobCount);
+	}
+	return files;
+}
+
+uint64_t hashParsingOptions(const ParsingOptions& options, uint64_t hash)
+{
+	//Every field is terminated so that e.g. an empty namespace followed by "a" differs from namespace "a"
+	auto addString = [&hash](std::string_view string) {
+		hash = hashString(string, hash);
+		hash = hashString(std::string_view("\0", 1), hash);
+	};
+	auto addBool = [&addString](bool value) { addString(value ? "1" : "0"); };
+	auto addList = [&addString](const std::vector<std::string>& list) {
+		addString(std::to_string(list.size()));
+		for (auto& element : list) addString(element);
+	};
+
+	addBool(options.useNamespaces);
+	addString(options.namespaceName);
+	addBool(options.excludeExtensions);
+	addList(options.includeExtensionList);
+	addList(options.excludeExtensionList);
+	addBool(options.replaceNames);
+	addString(options.namePrefixReplacement);
+	addBool(options.nameRemovePostfix);
+	addBool(options.replaceValues);
+	addString(options.valuePrefixReplacement);
+	addString(options.numberPrefix);
+	addBool(options.removeUnderscores);
+	addBool(options.removeStructureNames);
+	addBool(options.valueToLower);
+	addBool(options.valueCapitalizeStart);
+	addBool(options.valueRemovePostfix);
+	addBool(options.valueRemovePostfixOnCoreTypes);
+	addBool(options.splitOutput);
+	addBool(options.moduleOutput);
+	addBool(options.sortEnums);
+	addBool(options.generateToString);
+	addBool(options.generateFromString);
+	addBool(options.generateBitHelpers);
+	addBool(options.operatorTemplates);
+	addBool(options.generateReflection);
+	addBool(options.generateDenseIndex);
+	addBool(options.generateValidation);
+	addBool(options.generateBulkOperations);
+	addBool(options.generateHash);
+	addBool(options.generateFlatMap);
+	addBool(options.generateVkInterop);
+	//extensionTagNames is derived from the registry, which is hashed separately
+	return hash;
+}
+
+static std::string_view attributeView(const XMLElement* node, const char* name)
+{
+	const char* attribute = node->Attribute(name);
+	return attribute ? std::string_view(attribute) : std::string_view();
+}
+
+static RegistryValue readValueElement(const XMLElement* node, SymbolTable& symbols)
+{
+	RegistryValue value;
+	value.name = attributeView(node, "name");
+	value.value = attributeView(node, "value");
+	value.bitpos = attributeView(node, "bitpos");
+	value.alias = attributeView(node, "alias");
+	value.offset = attributeView(node, "offset");
+	value.comment = attributeView(node, "comment");
+	value.dir = attributeView(node, "dir");
+	value.extends = attributeView(node, "extends");
+	value.extnumber = attributeView(node, "extnumber");
+	value.nameSymbol = symbols.intern(value.name);
+	if (!value.extends.empty()) value.extendsSymbol = symbols.intern(value.extends);
+	return value;
+}
+
+static RegistryBlock readBlockElement(const XMLElement* node, SymbolTable& symbols)
+{
+	RegistryBlock block;
+	block.name = attributeView(node, "name");
+	block.nameSymbol = symbols.intern(block.name);
+	block.number = attributeView(node, "number");
+	block.requiresList = attributeView(node, "requires");
+	block.depends = attributeView(node, "depends");
+	block.promotedTo = attributeView(node, "promotedto");
+
+	const XMLElement* requireNode = node->FirstChildElement("require");
+	while (requireNode)
+	{
+		const XMLElement* enumNode = requireNode->FirstChildElement("enum");
+		while (enumNode)
+		{
+			if (enumNode->Attribute("extends")) {
+				block.values.push_back(readValueElement(enumNode, symbols));
+			}
+			enumNode = enumNode->NextSiblingElement("enum");
+		}
+		const XMLElement* typeNode = requireNode->FirstChildElement("type");
+		while (typeNode)
+		{
+			const char* referencedName = typeNode->Attribute("name");
+			if (referencedName) {
+				block.types.push_back(symbols.intern(referencedName));
+			}
+			typeNode = typeNode->NextSiblingElement("type");
+		}
+		requireNode = requireNode->NextSiblingElement("require");
+	}
+	return block;
+}
+
+bool readRegistryDocument(const XMLDocument& document, Registry& registry)
+{
+	const XMLElement* registryNode = document.FirstChildElement("registry");
+	if (!registryNode) {
+		return false;
 	}
+
+	const XMLElement* tagsElement = registryNode->FirstChildElement("tags");
+	if (tagsElement) {
+		const XMLElement* tag = tagsElement->FirstChildElement("tag");
+		while (tag)
+		{
+			const char* tagName = tag->Attribute("name");
+			if (tagName) registry.tags.push_back(tagName);
+			tag = tag->NextSiblingElement("tag");
+		}
+	}
+
+	const XMLElement* enumsNode = registryNode->FirstChildElement("enums");
 	while (enumsNode)
 	{
-		std::string name;
-		const char* nameC = enumsNode->Attribute("name");
-		if (nameC) {
-			name = nameC;
+		if (attributeView(enumsNode, "name") != "API Constants") {
+			RegistryEnum registryEnum;
+			registryEnum.name = attributeView(enumsNode, "name");
+			registryEnum.type = attributeView(enumsNode, "type");
+			registryEnum.bitwidth = attributeView(enumsNode, "bitwidth");
+			registryEnum.nameSymbol = registry.symbols.intern(registryEnum.name);
+
+			const XMLElement* valueNode = enumsNode->FirstChildElement("enum");
+			while (valueNode)
+			{
+				registryEnum.values.push_back(readValueElement(valueNode, registry.symbols));
+				valueNode = valueNode->NextSiblingElement("enum");
+			}
+			registry.enums.push_back(std::move(registryEnum));
 		}
-		enumMap.insert(std::pair<std::string, VulkanEnum>(name, parseBasicEnumNode(enumsNode, options)));
 		enumsNode = enumsNode->NextSiblingElement("enums");
 	}
+
+	const XMLElement* featureNode = registryNode->FirstChildElement("feature");
+	while (featureNode)
+	{
+		registry.features.push_back(readBlockElement(featureNode, registry.symbols));
+		featureNode = featureNode->NextSiblingElement("feature");
+	}
+
+	const XMLElement* extensionsNode = registryNode->FirstChildElement("extensions");
+	if (extensionsNode) {
+		const XMLElement* extensionNode = extensionsNode->FirstChildElement("extension");
+		while (extensionNode)
+		{
+			if (extensionNode->Attribute("name")) {
+				registry.extensions.push_back(readBlockElement(extensionNode, registry.symbols));
+			}
+			extensionNode = extensionNode->NextSiblingElement("extension");
+		}
+	}
+	return true;
+}
+
+EnumMap parseBasicEnums(const Registry& registry)
+{
+	EnumMap enumMap = EnumMap(registry.symbols);
+
+	if (registry.enums.empty()) {
+		std::cout << "Error: Unable to find enums nodes, is vk.xml valid?\n";
+		return enumMap;
+	}
+	for (auto& registryEnum : registry.enums) {
+		enumMap.insert(registryEnum.nameSymbol, parseBasicEnumNode(registryEnum));
+	}
 	return enumMap;
 }
 
-void includeFeatureEnums(const XMLElement* registry, const ParsingOptions& options, EnumMap& enumMap)
+void includeFeatureEnums(const Registry& registry, EnumMap& enumMap)
 {
-	const XMLElement* featureNode = registry->FirstChildElement("feature");
-	if (!featureNode) {
+	if (registry.features.empty()) {
 		std::cout << "Error: Unable to find feature nodes, is vk.xml valid?\n";
 		return;
 	}
-	while (featureNode)
-	{
-		parseExtensionEnumNode(featureNode, options, enumMap);
-		featureNode = featureNode->NextSiblingElement("feature");
+	for (auto& feature : registry.features) {
+		parseExtensionEnumNode(feature, enumMap);
 	}
 }
 
-void includeExtensionEnums(const XMLElement* registry, const ParsingOptions& options, EnumMap& enumMap)
+size_t includeExtensionEnums(const Registry& registry, const ParsingOptions& options, EnumMap& enumMap)
 {
-	const XMLElement* extensionsNode = registry->FirstChildElement("extensions");
-	if (!extensionsNode) {
+	if (registry.extensions.empty()) {
 		std::cout << "Error: Unable to find extensions nodes, is vk.xml valid?\n";
-		return;
+		return 0;
 	}
-	std::unordered_set<std::string> extensionNames;
+	ExtensionGraph graph = buildExtensionGraph(registry);
+	std::vector<bool> includedExtensions;
 
 	if (options.excludeExtensions) {
+		includedExtensions.resize(graph.size(), false);
 		for (auto& includedName : options.includeExtensionList) {
-			includeExtensionDependencies(extensionsNode, includedName, extensionNames);
+			includeExtensionDependencies(graph, includedName, includedExtensions);
 		}
 	}
 	else {
-		listExtensionNames(extensionsNode, extensionNames);
+		includedExtensions.resize(graph.size(), true);
 		for (auto& excludedName : options.excludeExtensionList) {
-			excludeDependentExtensions(extensionsNode, excludedName, extensionNames);
+			excludeDependentExtensions(graph, excludedName, includedExtensions);
 		}
 	}
 
-	const XMLElement* extensionNode = extensionsNode->FirstChildElement("extension");
-	while (extensionNode)
-	{
-		const char* name = extensionNode->Attribute("name");
-		if (name) {
-			if (extensionNames.find(name) != extensionNames.end())
-				parseExtensionEnumNode(extensionNode, options, enumMap);
+	//Graph ids are assigned in registry order
+	size_t includedCount = 0;
+	for (size_t i = 0; i < registry.extensions.size(); ++i) {
+		if (includedExtensions[i]) {
+			parseExtensionEnumNode(registry.extensions[i], enumMap);
+			++includedCount;
 		}
-		extensionNode = extensionNode->NextSiblingElement("extension");
 	}
+	return includedCount;
 }
 
-void writeEnums(const EnumMap& enumMap, std::ostream& outStream, const ParsingOptions& options)
+void transformNames(EnumMap& enums, const ParsingOptions& options)
 {
-	addLine(outStream, "#ifndef __VULKANENUMS_HPP");
-	addLine(outStream, "#define __VULKANENUMS_HPP");
+	for (auto& vulkanEnum : enums) {
+		if (!vulkanEnum.isIncluded) continue;
 
-	addLine(outStream, "#include <cstdint>");
+		vulkanEnum.name = vulkanEnum.originalName;
+		processName(options, vulkanEnum.name);
+		for (auto& value : vulkanEnum.values()) {
+			if (value.originalName.empty()) continue;
+			value.name = value.originalName;
+			processValueName(options, value.name, vulkanEnum.originalName);
+		}
+		for (auto& value : vulkanEnum.aliasValues()) {
+			if (!value.originalName.empty()) {
+				value.name = value.originalName;
+				processValueName(options, value.name, vulkanEnum.originalName);
+			}
+			value.alias = value.originalAlias;
+			processValueName(options, value.alias, vulkanEnum.originalName);
+		}
+	}
+}
+
+//Underlying type declaration of an enum, including the leading colon
+static std::string_view enumBaseType(VulkanEnumType type)
+{
+	switch (type) {
+	case VulkanEnumType::Bitmask:
+		return " : uint32_t";
+	case VulkanEnumType::Bitmask64:
+		return " : uint64_t";
+	default:
+		return " : int32_t";
+	}
+}
+
+//Trait and function templates shared by all bitmask enums, which opt in by specializing IsBitmaskEnum
+static void writeBitmaskSupportCode(CodeWriter& writer, const ParsingOptions& options)
+{
+	writer.addLine("#ifndef __VULKANENUMS_BITMASK_SUPPORT");
+	writer.addLine("#define __VULKANENUMS_BITMASK_SUPPORT");
+	writer.addLine("//Specialized as std::true_type for every bitmask enum");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("struct IsBitmaskEnum : std::false_type {};");
+	writer.addLine("namespace VulkanEnumsDetail {");
+	writer.indent();
+	writer.addLine("template<typename Enum, typename Result>");
+	writer.addLine("using EnableIfBitmask = std::enable_if_t<IsBitmaskEnum<Enum>::value, Result>;");
+	if (options.generateBitHelpers) {
+		writer.addLine("template<typename Bits>");
+		writer.addLine("constexpr int countTrailingZeros(Bits bits) {");
+		writer.addLine("#if defined(__cpp_lib_bitops)");
+		writer.indent();
+		writer.addLine("return std::countr_zero(bits);");
+		writer.outdent();
+		writer.addLine("#elif defined(__GNUC__)");
+		writer.indent();
+		writer.addLine("return bits ? __builtin_ctzll(bits) : static_cast<int>(sizeof(Bits) * 8);");
+		writer.outdent();
+		writer.addLine("#else");
+		writer.indent();
+		writer.addLine("int count = 0;");
+		writer.addLine("for (; count < static_cast<int>(sizeof(Bits) * 8) && !((bits >> count) & 1); ++count) {}");
+		writer.addLine("return count;");
+		writer.outdent();
+		writer.addLine("#endif");
+		writer.addLine("}");
+		writer.addLine("template<typename Bits>");
+		writer.addLine("constexpr int countBits(Bits bits) {");
+		writer.addLine("#if defined(__cpp_lib_bitops)");
+		writer.indent();
+		writer.addLine("return std::popcount(bits);");
+		writer.outdent();
+		writer.addLine("#elif defined(__GNUC__)");
+		writer.indent();
+		writer.addLine("return __builtin_popcountll(bits);");
+		writer.outdent();
+		writer.addLine("#else");
+		writer.indent();
+		writer.addLine("int count = 0;");
+		writer.addLine("for (; bits; bits &= bits - 1) ++count;");
+		writer.addLine("return count;");
+		writer.outdent();
+		writer.addLine("#endif");
+		writer.addLine("}");
+	}
+	writer.outdent();
+	writer.addLine("}");
+
+	if (options.operatorTemplates) {
+		writer.addLine("//Operators of all bitmask enums, usable in constant expressions");
+		for (std::string_view operatorName : { "|", "&", "^" }) {
+			writer.addLine("template<typename Enum>");
+			writer.addLine("constexpr VulkanEnumsDetail::EnableIfBitmask<Enum, Enum> operator", operatorName, "(Enum one, Enum other) {");
+			writer.indent();
+			writer.addLine("return static_cast<Enum>(static_cast<std::underlying_type_t<Enum>>(one) ", operatorName,
+						   " static_cast<std::underlying_type_t<Enum>>(other));");
+			writer.outdent();
+			writer.addLine("}");
+		}
+		writer.addLine("template<typename Enum>");
+		writer.addLine("constexpr VulkanEnumsDetail::EnableIfBitmask<Enum, Enum> operator~(Enum obj) {");
+		writer.indent();
+		writer.addLine("return static_cast<Enum>(~static_cast<std::underlying_type_t<Enum>>(obj));");
+		writer.outdent();
+		writer.addLine("}");
+		for (std::string_view operatorName : { "|", "&", "^" }) {
+			writer.addLine("template<typename Enum>");
+			writer.addLine("constexpr VulkanEnumsDetail::EnableIfBitmask<Enum, Enum&> operator", operatorName, "=(Enum& one, Enum other) {");
+			writer.indent();
+			writer.addLine("return one = one ", operatorName, " other;");
+			writer.outdent();
+			writer.addLine("}");
+		}
+	}
+	if (options.generateBitHelpers) {
+		writer.addLine("//Iterates over the set bits of a bitmask, lowest first. Clearing the lowest bit is all an increment does.");
+		writer.addLine("template<typename Enum>");
+		writer.addLine("class BitIterator {");
+		writer.addLine("public:");
+		writer.indent();
+		writer.addLine("using Bits = std::underlying_type_t<Enum>;");
+		writer.addLine("constexpr explicit BitIterator(Bits bits) : m_bits(bits) {}");
+		writer.addLine("constexpr Enum operator*() const { return static_cast<Enum>(m_bits & (~m_bits + 1)); }");
+		writer.addLine("constexpr BitIterator& operator++() {");
+		writer.indent();
+		writer.addLine("m_bits &= m_bits - 1;");
+		writer.addLine("return *this;");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("constexpr bool operator==(BitIterator other) const { return m_bits == other.m_bits; }");
+		writer.addLine("constexpr bool operator!=(BitIterator other) const { return m_bits != other.m_bits; }");
+		writer.outdent();
+		writer.addLine("private:");
+		writer.indent();
+		writer.addLine("Bits m_bits;");
+		writer.outdent();
+		writer.addLine("};");
+		writer.addLine("template<typename Enum>");
+		writer.addLine("struct BitRange {");
+		writer.indent();
+		writer.addLine("std::underlying_type_t<Enum> bits;");
+		writer.addLine("constexpr BitIterator<Enum> begin() const { return BitIterator<Enum>(bits); }");
+		writer.addLine("constexpr BitIterator<Enum> end() const { return BitIterator<Enum>(0); }");
+		writer.outdent();
+		writer.addLine("};");
 
-	addLine(outStream, "#ifdef _MSC_VER");
-	addLine(outStream, "#pragma warning( disable : 4146 )"); //Disable sign on unsigned value warnings (triggered on "-1U")
-	addLine(outStream, "#endif");
+		writer.addLine("//Range over the set bits of flags, for (auto bit : setBits(flags))");
+		writer.addLine("template<typename Enum>");
+		writer.addLine("constexpr VulkanEnumsDetail::EnableIfBitmask<Enum, BitRange<Enum>> setBits(Enum flags) {");
+		writer.indent();
+		writer.addLine("return BitRange<Enum>{ static_cast<std::underlying_type_t<Enum>>(flags) };");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("//Calls function with every set bit of flags, lowest first");
+		writer.addLine("template<typename Enum, typename Function>");
+		writer.addLine("constexpr VulkanEnumsDetail::EnableIfBitmask<Enum, void> forEachBit(Enum flags, Function&& function) {");
+		writer.indent();
+		writer.addLine("for (auto bits = static_cast<std::underlying_type_t<Enum>>(flags); bits; bits &= bits - 1) {");
+		writer.indent();
+		writer.addLine("function(static_cast<Enum>(bits & (~bits + 1)));");
+		writer.outdent();
+		writer.addLine("}");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("//Position of the lowest set bit, the number of bits of the enum if none is set");
+		writer.addLine("template<typename Enum>");
+		writer.addLine("constexpr VulkanEnumsDetail::EnableIfBitmask<Enum, int> bitIndex(Enum bit) {");
+		writer.indent();
+		writer.addLine("return VulkanEnumsDetail::countTrailingZeros(static_cast<std::underlying_type_t<Enum>>(bit));");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("template<typename Enum>");
+		writer.addLine("constexpr VulkanEnumsDetail::EnableIfBitmask<Enum, int> popcount(Enum flags) {");
+		writer.indent();
+		writer.addLine("return VulkanEnumsDetail::countBits(static_cast<std::underlying_type_t<Enum>>(flags));");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("//True if any of bits is set in flags, any bit without bits");
+		writer.addLine("template<typename Enum>");
+		writer.addLine("constexpr VulkanEnumsDetail::EnableIfBitmask<Enum, bool> any(Enum flags, Enum bits = static_cast<Enum>(~std::underlying_type_t<Enum>(0))) {");
+		writer.indent();
+		writer.addLine("return (static_cast<std::underlying_type_t<Enum>>(flags) & static_cast<std::underlying_type_t<Enum>>(bits)) != 0;");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("//True if all of bits are set in flags");
+		writer.addLine("template<typename Enum>");
+		writer.addLine("constexpr VulkanEnumsDetail::EnableIfBitmask<Enum, bool> all(Enum flags, Enum bits) {");
+		writer.indent();
+		writer.addLine("auto mask = static_cast<std::underlying_type_t<Enum>>(bits);");
+		writer.addLine("return (static_cast<std::underlying_type_t<Enum>>(flags) & mask) == mask;");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("//True if none of bits is set in flags, no bit without bits");
+		writer.addLine("template<typename Enum>");
+		writer.addLine("constexpr VulkanEnumsDetail::EnableIfBitmask<Enum, bool> none(Enum flags, Enum bits = static_cast<Enum>(~std::underlying_type_t<Enum>(0))) {");
+		writer.indent();
+		writer.addLine("return !any(flags, bits);");
+		writer.outdent();
+		writer.addLine("}");
+	}
+	writer.addLine("#endif");
+}
+
+//Binary search over the runs of consecutive values, shared by toDenseIndex and isValid
+static void writeRunSupportCode(CodeWriter& writer)
+{
+	writer.addLine("#ifndef __VULKANENUMS_VALUE_RUNS");
+	writer.addLine("#define __VULKANENUMS_VALUE_RUNS");
+	writer.addLine("namespace VulkanEnumsDetail {");
+	writer.indent();
+	writer.addLine("//Index of the last of the sorted runFirsts not greater than value, runCount if there is none");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("constexpr size_t findRun(const Enum* runFirsts, size_t runCount, Enum value) {");
+	writer.indent();
+	writer.addLine("size_t first = 0;");
+	writer.addLine("size_t remaining = runCount;");
+	writer.addLine("while (remaining > 0) {");
+	writer.indent();
+	writer.addLine("size_t half = remaining / 2;");
+	writer.addLine("if (!(value < runFirsts[first + half])) {");
+	writer.indent();
+	writer.addLine("first += half + 1;");
+	writer.addLine("remaining -= half + 1;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("else {");
+	writer.indent();
+	writer.addLine("remaining = half;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("return first ? first - 1 : runCount;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("#endif");
+}
+
+//Valid-bit masks of bitmask enums
+static void writeValidationSupportCode(CodeWriter& writer)
+{
+	writer.addLine("#ifndef __VULKANENUMS_VALIDATION");
+	writer.addLine("#define __VULKANENUMS_VALIDATION");
+	writer.addLine("//All bits of a bitmask enum that are values on their own. Specialized for every bitmask enum.");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline constexpr Enum kAllBits = static_cast<Enum>(0);");
+	writer.addLine("#endif");
+}
+
+//kDenseCount, fromDenseIndex and EnumArray, which toDenseIndex of each enum plugs into
+static void writeDenseIndexSupportCode(CodeWriter& writer)
+{
+	writer.addLine("#ifndef __VULKANENUMS_DENSE_INDEX");
+	writer.addLine("#define __VULKANENUMS_DENSE_INDEX");
+	writer.addLine("//Number of values of an enum, the values are mapped to 0 to kDenseCount - 1 by toDenseIndex. Specialized for every enum.");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline constexpr size_t kDenseCount = 0;");
+	writer.addLine("//Value at index, index must be less than kDenseCount. Specialized for every enum.");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("constexpr Enum fromDenseIndex(size_t index);");
+	writer.addLine("//Array with one element per value of Enum, indexed by toDenseIndex");
+	writer.addLine("template<typename Enum, typename T>");
+	writer.addLine("struct EnumArray {");
+	writer.indent();
+	writer.addLine("std::array<T, kDenseCount<Enum>> elements;");
+	writer.addLine("");
+	writer.addLine("constexpr T& operator[](Enum value) { return elements[toDenseIndex(value)]; }");
+	writer.addLine("constexpr const T& operator[](Enum value) const { return elements[toDenseIndex(value)]; }");
+	writer.addLine("constexpr size_t size() const { return kDenseCount<Enum>; }");
+	writer.addLine("constexpr T* begin() { return elements.data(); }");
+	writer.addLine("constexpr T* end() { return elements.data() + kDenseCount<Enum>; }");
+	writer.addLine("constexpr const T* begin() const { return elements.data(); }");
+	writer.addLine("constexpr const T* end() const { return elements.data() + kDenseCount<Enum>; }");
+	writer.outdent();
+	writer.addLine("};");
+	writer.addLine("#endif");
+}
+
+//Writes one vector iteration of denseIndexMany with the intrinsics prefixed by prefix (_mm or _mm256) on laneCount lanes
+static void writeBulkVectorLoop(CodeWriter& writer, std::string_view prefix, std::string_view vectorType, size_t laneCount, std::string_view allLanesMask)
+{
+	writer.addLine("if constexpr (Runs::runCount <= maxVectorRunCount) {");
+	writer.indent();
+	writer.addLine("const ", vectorType, " signBit = ", prefix, "_set1_epi32(INT32_MIN);");
+	writer.addLine(vectorType, " validLanes = ", prefix, "_set1_epi32(-1);");
+	writer.addLine("for (; i + ", laneCount, " <= count; i += ", laneCount, ") {");
+	writer.indent();
+	writer.addLine(vectorType, " value = ", prefix, "_loadu_si", laneCount * 32, "(reinterpret_cast<const ", vectorType, "*>(values + i));");
+	writer.addLine(vectorType, " index = ", prefix, "_set1_epi32(static_cast<int32_t>(Runs::valueCount));");
+	writer.addLine(vectorType, " isValue = ", prefix, "_setzero_si", laneCount * 32, "();");
+	writer.addLine("for (size_t run = 0; run < Runs::runCount; ++run) {");
+	writer.indent();
+	writer.addLine("//There are only signed compares, flipping the sign bit of both sides makes offset < length unsigned");
+	writer.addLine(vectorType, " offset = ", prefix, "_sub_epi32(value, ", prefix, "_set1_epi32(Runs::firsts[run]));");
+	writer.addLine(vectorType, " length = ", prefix, "_set1_epi32(static_cast<int32_t>(Runs::lengths[run] ^ 0x80000000U));");
+	writer.addLine(vectorType, " inRun = ", prefix, "_cmpgt_epi32(length, ", prefix, "_xor_si", laneCount * 32, "(offset, signBit));");
+	writer.addLine(vectorType, " runIndex = ", prefix, "_add_epi32(offset, ", prefix, "_set1_epi32(static_cast<int32_t>(Runs::indices[run])));");
+	writer.addLine("isValue = ", prefix, "_or_si", laneCount * 32, "(isValue, inRun);");
+	if (laneCount == 8) {
+		writer.addLine("index = ", prefix, "_blendv_epi8(index, runIndex, inRun);");
+	}
+	else {
+		writer.addLine("index = ", prefix, "_or_si128(", prefix, "_and_si128(inRun, runIndex), ", prefix, "_andnot_si128(inRun, index));");
+	}
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("validLanes = ", prefix, "_and_si", laneCount * 32, "(validLanes, isValue);");
+	writer.addLine("if (indices) ", prefix, "_storeu_si", laneCount * 32, "(reinterpret_cast<", vectorType, "*>(indices + i), index);");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("allValid = ", prefix, "_movemask_epi8(validLanes) == ", allLanesMask, ";");
+	writer.outdent();
+	writer.addLine("}");
+}
+
+//EnumRuns, which every plain enum specializes, and validateMany and toDenseIndexMany working on it
+static void writeBulkSupportCode(CodeWriter& writer)
+{
+	writer.addLine("#ifndef __VULKANENUMS_BULK_OPERATIONS");
+	writer.addLine("#define __VULKANENUMS_BULK_OPERATIONS");
+	writer.addLine("namespace VulkanEnumsDetail {");
+	writer.indent();
+	writer.addLine("//Runs of consecutive values of a plain enum: the first value, length and dense index of the first value of each run.");
+	writer.addLine("//Specialized for every enum that isn't a bitmask.");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("struct EnumRuns;");
+	writer.addLine("//Enums with more runs are searched by binary search value by value, checking every run would be slower");
+	writer.addLine("inline constexpr size_t maxVectorRunCount = 16;");
+	writer.addLine("//Dense index of the number of a value, valueCount if it isn't one");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("constexpr uint32_t runDenseIndex(int32_t value) {");
+	writer.indent();
+	writer.addLine("using Runs = EnumRuns<Enum>;");
+	writer.addLine("if constexpr (Runs::runCount <= maxVectorRunCount) {");
+	writer.indent();
+	writer.addLine("for (size_t run = 0; run < Runs::runCount; ++run) {");
+	writer.indent();
+	writer.addLine("uint32_t offset = static_cast<uint32_t>(value) - static_cast<uint32_t>(Runs::firsts[run]);");
+	writer.addLine("if (offset < Runs::lengths[run]) return Runs::indices[run] + offset;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("return Runs::valueCount;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("else {");
+	writer.indent();
+	writer.addLine("size_t run = findRun(Runs::firsts, Runs::runCount, value);");
+	writer.addLine("if (run == Runs::runCount) return Runs::valueCount;");
+	writer.addLine("uint32_t offset = static_cast<uint32_t>(value) - static_cast<uint32_t>(Runs::firsts[run]);");
+	writer.addLine("return offset < Runs::lengths[run] ? Runs::indices[run] + offset : Runs::valueCount;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("//Writes the dense index of every value to indices unless it is null, valueCount for numbers that aren't values.");
+	writer.addLine("//Value is Enum or int32_t. Returns true if all numbers are values.");
+	writer.addLine("template<typename Enum, typename Value>");
+	writer.addLine("inline bool denseIndexMany(const Value* values, size_t count, uint32_t* indices) {");
+	writer.indent();
+	writer.addLine("using Runs = EnumRuns<Enum>;");
+	writer.addLine("bool allValid = true;");
+	writer.addLine("size_t i = 0;");
+	writer.addLine("#if defined(__VULKANENUMS_AVX2)");
+	writeBulkVectorLoop(writer, "_mm256", "__m256i", 8, "-1");
+	writer.addLine("#elif defined(__VULKANENUMS_SSE2)");
+	writeBulkVectorLoop(writer, "_mm", "__m128i", 4, "0xFFFF");
+	writer.addLine("#endif");
+	writer.addLine("for (; i < count; ++i) {");
+	writer.indent();
+	writer.addLine("uint32_t index = runDenseIndex<Enum>(static_cast<int32_t>(values[i]));");
+	writer.addLine("allValid &= index != Runs::valueCount;");
+	writer.addLine("if (indices) indices[i] = index;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("return allValid;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.outdent();
+	writer.addLine("}");
+
+	writer.addLine("//True if all count values are values of Enum, e.g. after reading them from disk.");
+	writer.addLine("//Enums with few runs of consecutive values are checked 8 (AVX2) or 4 (SSE2) values at a time.");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline bool validateMany(const Enum* values, size_t count) {");
+	writer.indent();
+	writer.addLine("return VulkanEnumsDetail::denseIndexMany<Enum>(values, count, nullptr);");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline bool validateMany(const int32_t* values, size_t count) {");
+	writer.indent();
+	writer.addLine("return VulkanEnumsDetail::denseIndexMany<Enum>(values, count, nullptr);");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("//Writes toDenseIndex of the count values to indices, kDenseCount for numbers that aren't values.");
+	writer.addLine("//Returns true if all numbers are values.");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline bool toDenseIndexMany(const Enum* values, size_t count, uint32_t* indices) {");
+	writer.indent();
+	writer.addLine("return VulkanEnumsDetail::denseIndexMany<Enum>(values, count, indices);");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline bool toDenseIndexMany(const int32_t* values, size_t count, uint32_t* indices) {");
+	writer.indent();
+	writer.addLine("return VulkanEnumsDetail::denseIndexMany<Enum>(values, count, indices);");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("#ifdef __cpp_lib_span");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline bool validateMany(std::span<const Enum> values) {");
+	writer.indent();
+	writer.addLine("return VulkanEnumsDetail::denseIndexMany<Enum>(values.data(), values.size(), nullptr);");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline bool validateMany(std::span<const int32_t> values) {");
+	writer.indent();
+	writer.addLine("return VulkanEnumsDetail::denseIndexMany<Enum>(values.data(), values.size(), nullptr);");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("//indices must have at least as many elements as values");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline bool toDenseIndexMany(std::span<const Enum> values, std::span<uint32_t> indices) {");
+	writer.indent();
+	writer.addLine("return VulkanEnumsDetail::denseIndexMany<Enum>(values.data(), values.size(), indices.data());");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline bool toDenseIndexMany(std::span<const int32_t> values, std::span<uint32_t> indices) {");
+	writer.indent();
+	writer.addLine("return VulkanEnumsDetail::denseIndexMany<Enum>(values.data(), values.size(), indices.data());");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("#endif");
+	writer.addLine("#endif");
+}
+
+//EnumFlatMap and the slot its keys are probed from. Its capacity is specialized for every plain enum.
+static void writeFlatMapSupportCode(CodeWriter& writer, const ParsingOptions& options)
+{
+	writer.addLine("#ifndef __VULKANENUMS_FLAT_MAP");
+	writer.addLine("#define __VULKANENUMS_FLAT_MAP");
+	writer.addLine("//Number of slots of EnumFlatMap<Enum, T>, enough for all values of Enum. Specialized for every enum that isn't a bitmask.");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("inline constexpr size_t kFlatMapCapacity = 0;");
+	writer.addLine("namespace VulkanEnumsDetail {");
+	writer.indent();
+	writer.addLine("template<typename Enum>");
+	writer.addLine("constexpr size_t flatMapSlot(Enum key) {");
+	writer.indent();
+	if (options.generateDenseIndex) {
+		//The capacity has a slot for every value and one for kDenseCount, so values never collide
+		writer.addLine("return toDenseIndex(key);");
+	}
+	else {
+		//Fibonacci hashing spreads values like 1000156000 + n, the high bits are scaled to the capacity without a division
+		writer.addLine("uint64_t mixed = static_cast<uint64_t>(static_cast<uint32_t>(key)) * 0x9E3779B97F4A7C15ULL;");
+		writer.addLine("return static_cast<size_t>(((mixed >> 32) * kFlatMapCapacity<Enum>) >> 32);");
+	}
+	writer.outdent();
+	writer.addLine("}");
+	writer.outdent();
+	writer.addLine("}");
+
+	if (options.generateDenseIndex) {
+		writer.addLine("//Map from the values of an enum that isn't a bitmask to T, stored in place in the slot of their dense index.");
+		writer.addLine("//It never allocates and can be used in constant expressions. T has to be default constructible.");
+		writer.addLine("//The capacity is fixed, only one key other than the values of Enum fits.");
+	}
+	else {
+		writer.addLine("//Map from the values of an enum that isn't a bitmask to T, stored in place with open addressing and linear probing.");
+		writer.addLine("//It never allocates and can be used in constant expressions. T has to be default constructible.");
+		writer.addLine("//The capacity is fixed, keys other than the values of Enum can fill it up.");
+	}
+	writer.addLine("template<typename Enum, typename T>");
+	writer.addLine("class EnumFlatMap {");
+	writer.addLine("public:");
+	writer.indent();
+	writer.addLine("static constexpr size_t capacity = kFlatMapCapacity<Enum>;");
+	writer.addLine("static_assert(capacity > 0, \"EnumFlatMap requires an enum that isn't a bitmask\");");
+	writer.addLine("");
+	writer.addLine("//Element of key, nullptr if the map doesn't contain it");
+	writer.addLine("constexpr T* find(Enum key) {");
+	writer.indent();
+	writer.addLine("size_t slot = findSlot(key);");
+	writer.addLine("return slot != capacity && m_isOccupied[slot] ? &m_values[slot] : nullptr;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("constexpr const T* find(Enum key) const {");
+	writer.indent();
+	writer.addLine("size_t slot = findSlot(key);");
+	writer.addLine("return slot != capacity && m_isOccupied[slot] ? &m_values[slot] : nullptr;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("constexpr bool contains(Enum key) const { return find(key) != nullptr; }");
+	writer.addLine("//Inserts value unless the map already contains key. Returns the element of key, nullptr if the map is full,");
+	writer.addLine("//and whether value was inserted.");
+	writer.addLine("constexpr std::pair<T*, bool> insert(Enum key, const T& value) {");
+	writer.indent();
+	writer.addLine("size_t slot = findSlot(key);");
+	writer.addLine("if (slot == capacity) return { nullptr, false };");
+	writer.addLine("if (m_isOccupied[slot]) return { &m_values[slot], false };");
+	writer.addLine("m_keys[slot] = key;");
+	writer.addLine("m_values[slot] = value;");
+	writer.addLine("m_isOccupied[slot] = true;");
+	writer.addLine("++m_size;");
+	writer.addLine("return { &m_values[slot], true };");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("//Element of key, inserted default constructed if the map doesn't contain it. The map must not be full.");
+	writer.addLine("constexpr T& operator[](Enum key) {");
+	writer.indent();
+	writer.addLine("return *insert(key, T()).first;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("//Removes key, returns whether the map contained it");
+	writer.addLine("constexpr bool erase(Enum key) {");
+	writer.indent();
+	writer.addLine("size_t hole = findSlot(key);");
+	writer.addLine("if (hole == capacity || !m_isOccupied[hole]) return false;");
+	if (!options.generateDenseIndex) {
+		writer.addLine("//Moves back the following elements that can't be found anymore once hole is empty, instead of leaving a tombstone");
+		writer.addLine("size_t slot = nextSlot(hole);");
+		writer.addLine("for (size_t i = 1; i < capacity && m_isOccupied[slot]; ++i) {");
+		writer.indent();
+		writer.addLine("size_t firstSlot = VulkanEnumsDetail::flatMapSlot(m_keys[slot]);");
+		writer.addLine("bool isFoundFromFirstSlot = hole < slot ? hole < firstSlot && firstSlot <= slot : hole < firstSlot || firstSlot <= slot;");
+		writer.addLine("if (!isFoundFromFirstSlot) {");
+		writer.indent();
+		writer.addLine("m_keys[hole] = m_keys[slot];");
+		writer.addLine("m_values[hole] = std::move(m_values[slot]);");
+		writer.addLine("hole = slot;");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("slot = nextSlot(slot);");
+		writer.outdent();
+		writer.addLine("}");
+	}
+	writer.addLine("m_values[hole] = T();");
+	writer.addLine("m_isOccupied[hole] = false;");
+	writer.addLine("--m_size;");
+	writer.addLine("return true;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("constexpr void clear() {");
+	writer.indent();
+	writer.addLine("for (size_t slot = 0; slot < capacity; ++slot) {");
+	writer.indent();
+	writer.addLine("m_values[slot] = T();");
+	writer.addLine("m_isOccupied[slot] = false;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("m_size = 0;");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("constexpr size_t size() const { return m_size; }");
+	writer.addLine("constexpr bool empty() const { return m_size == 0; }");
+	writer.addLine("//Calls function(key, element) for every element, in slot order");
+	writer.addLine("template<typename Function>");
+	writer.addLine("constexpr void forEach(Function&& function) {");
+	writer.indent();
+	writer.addLine("for (size_t slot = 0; slot < capacity; ++slot) {");
+	writer.indent();
+	writer.addLine("if (m_isOccupied[slot]) function(m_keys[slot], m_values[slot]);");
+	writer.outdent();
+	writer.addLine("}");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("template<typename Function>");
+	writer.addLine("constexpr void forEach(Function&& function) const {");
+	writer.indent();
+	writer.addLine("for (size_t slot = 0; slot < capacity; ++slot) {");
+	writer.indent();
+	writer.addLine("if (m_isOccupied[slot]) function(m_keys[slot], m_values[slot]);");
+	writer.outdent();
+	writer.addLine("}");
+	writer.outdent();
+	writer.addLine("}");
+	writer.outdent();
+	writer.addLine("private:");
+	writer.indent();
+	writer.addLine("static constexpr size_t nextSlot(size_t slot) { return slot + 1 == capacity ? 0 : slot + 1; }");
+	writer.addLine("//Slot of key or the empty slot it would be inserted into, capacity if neither exists");
+	writer.addLine("constexpr size_t findSlot(Enum key) const {");
+	writer.indent();
+	writer.addLine("size_t slot = VulkanEnumsDetail::flatMapSlot(key);");
+	if (options.generateDenseIndex) {
+		//Every value has its own slot, keys other than the values share the last one
+		writer.addLine("return !m_isOccupied[slot] || m_keys[slot] == key ? slot : capacity;");
+	}
+	else {
+		writer.addLine("for (size_t i = 0; i < capacity; ++i) {");
+		writer.indent();
+		writer.addLine("if (!m_isOccupied[slot] || m_keys[slot] == key) return slot;");
+		writer.addLine("slot = nextSlot(slot);");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("return capacity;");
+	}
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("");
+	writer.addLine("std::array<Enum, capacity> m_keys = {};");
+	writer.addLine("std::array<T, capacity> m_values = {};");
+	writer.addLine("std::array<bool, capacity> m_isOccupied = {};");
+	writer.addLine("size_t m_size = 0;");
+	writer.outdent();
+	writer.addLine("};");
+	writer.addLine("#endif");
+}
+
+static void writeVkInteropSupportCode(CodeWriter& writer)
+{
+	writer.addLine("#if !defined(__VULKANENUMS_VK_INTEROP) && defined(__VULKANENUMS_VULKAN_HEADERS)");
+	writer.addLine("#define __VULKANENUMS_VK_INTEROP");
+	writer.addLine("//Type of an enum in vulkan_core.h: the Vk enum of plain enums, the VkFlags typedef of bitmask enums.");
+	writer.addLine("//Specialized for every enum the included vulkan_core.h defines.");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("struct VulkanType;");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("using VkType = typename VulkanType<Enum>::Type;");
+	writer.addLine("");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("constexpr VkType<Enum> toVk(Enum value) { return static_cast<VkType<Enum>>(value); }");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("constexpr Enum fromVk(VkType<Enum> value) { return static_cast<Enum>(value); }");
+	writer.addLine("//Arrays of enums as arrays of their Vulkan type without copying, e.g. for pDynamicStates.");
+	writer.addLine("//The static_asserts next to every VulkanType specialization guarantee that the layout and values match.");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("const VkType<Enum>* asVkArray(const Enum* values) { return reinterpret_cast<const VkType<Enum>*>(values); }");
+	writer.addLine("template<typename Enum>");
+	writer.addLine("VkType<Enum>* asVkArray(Enum* values) { return reinterpret_cast<VkType<Enum>*>(values); }");
+	writer.addLine("#ifdef __cpp_lib_span");
+	writer.addLine("template<typename Enum, size_t Extent>");
+	writer.addLine("std::span<const VkType<Enum>, Extent> asVkSpan(std::span<const Enum, Extent> values) {");
+	writer.indent();
+	writer.addLine("return std::span<const VkType<Enum>, Extent>(asVkArray(values.data()), values.size());");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("template<typename Enum, size_t Extent>");
+	writer.addLine("std::span<VkType<Enum>, Extent> asVkSpan(std::span<Enum, Extent> values) {");
+	writer.indent();
+	writer.addLine("return std::span<VkType<Enum>, Extent>(asVkArray(values.data()), values.size());");
+	writer.outdent();
+	writer.addLine("}");
+	writer.addLine("#endif");
+	writer.addLine("#endif");
+}
+
+//Helpers shared by the functions of all enums. Split headers can be included together, so they're guarded by a macro.
+static void writeSupportCode(CodeWriter& writer, const ParsingOptions& options)
+{
+	if (options.generateBitHelpers || options.operatorTemplates) {
+		writeBitmaskSupportCode(writer, options);
+	}
+	if (options.generateReflection) {
+		writer.addLine("#ifndef __VULKANENUMS_REFLECTION");
+		writer.addLine("#define __VULKANENUMS_REFLECTION");
+		writer.addLine("//Values, count, minimum and maximum of an enum. Specialized for every enum.");
+		writer.addLine("template<typename Enum>");
+		writer.addLine("struct EnumReflection;");
+		writer.addLine("#endif");
+	}
+	if (options.generateDenseIndex || options.generateValidation || options.generateBulkOperations) {
+		writeRunSupportCode(writer);
+	}
+	if (options.generateDenseIndex) {
+		writeDenseIndexSupportCode(writer);
+	}
+	if (options.generateValidation) {
+		writeValidationSupportCode(writer);
+	}
+	if (options.generateBulkOperations) {
+		writeBulkSupportCode(writer);
+	}
+	if (options.generateFlatMap) {
+		writeFlatMapSupportCode(writer, options);
+	}
+	if (options.generateVkInterop) {
+		writeVkInteropSupportCode(writer);
+	}
+	if (!options.generateToString && !options.generateFromString) return;
+
+	writer.addLine("#ifndef __VULKANENUMS_STRING_TABLES");
+	writer.addLine("#define __VULKANENUMS_STRING_TABLES");
+	writer.addLine("namespace VulkanEnumsDetail {");
+	writer.indent();
+	writer.addLine("//String index of a table storing all strings back to back, string i starts at offsets[i] and ends at offsets[i + 1]");
+	writer.addLine("template<typename Offset>");
+	writer.addLine("constexpr std::string_view tableString(const char* strings, const Offset* offsets, size_t index) {");
+	writer.indent();
+	writer.addLine("return std::string_view(strings + offsets[index], offsets[index + 1] - offsets[index]);");
+	writer.outdent();
+	writer.addLine("}");
+	if (options.generateToString) {
+		writer.addLine("//Index of key in the count sorted keys, count if it isn't one of them");
+		writer.addLine("template<typename Key>");
+		writer.addLine("constexpr size_t findSortedKey(const Key* keys, size_t count, Key key) {");
+		writer.indent();
+		writer.addLine("size_t first = 0;");
+		writer.addLine("size_t remaining = count;");
+		writer.addLine("while (remaining > 0) {");
+		writer.indent();
+		writer.addLine("size_t half = remaining / 2;");
+		writer.addLine("if (keys[first + half] < key) {");
+		writer.indent();
+		writer.addLine("first += half + 1;");
+		writer.addLine("remaining -= half + 1;");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("else {");
+		writer.indent();
+		writer.addLine("remaining = half;");
+		writer.outdent();
+		writer.addLine("}");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("return first < count && keys[first] == key ? first : count;");
+		writer.outdent();
+		writer.addLine("}");
+	}
+	if (options.generateFromString) {
+		//Has to match nameHash and perfectHashSlot of the generator, which built the tables
+		writer.addLine("//64-bit FNV-1a");
+		writer.addLine("constexpr uint64_t nameHash(std::string_view name) {");
+		writer.indent();
+		writer.addLine("uint64_t hash = 14695981039346656037ULL;");
+		writer.addLine("for (char character : name) {");
+		writer.indent();
+		writer.addLine("hash ^= static_cast<unsigned char>(character);");
+		writer.addLine("hash *= 1099511628211ULL;");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("return hash;");
+		writer.outdent();
+		writer.addLine("}");
+		writer.addLine("//Slot of a name in a perfect hash table, displacement is chosen per bucket (hash % bucket count) by the generator");
+		writer.addLine("constexpr size_t perfectHashSlot(uint64_t hash, uint64_t displacement, size_t slotCount) {");
+		writer.indent();
+		writer.addLine("uint64_t mixed = hash ^ (displacement * 0x9E3779B97F4A7C15ULL);");
+		writer.addLine("mixed ^= mixed >> 31;");
+		writer.addLine("mixed *= 0xBF58476D1CE4E5B9ULL;");
+		writer.addLine("mixed ^= mixed >> 29;");
+		writer.addLine("return static_cast<size_t>(mixed % slotCount);");
+		writer.outdent();
+		writer.addLine("}");
+	}
+	writer.outdent();
+	writer.addLine("}");
+	if (options.generateFromString) {
+		writer.addLine("//Value with the given name as written in this header. Specialized for every enum.");
+		writer.addLine("template<typename Enum>");
+		writer.addLine("constexpr std::optional<Enum> fromString(std::string_view name);");
+	}
+	writer.addLine("#endif");
+}
+
+//Standard headers needed by the enums. Definitions additionally need the headers of the functions enabled in options.
+static void writeIncludes(CodeWriter& writer, const ParsingOptions& options, bool hasDefinitions = true)
+{
+	writer.addLine("#include <cstdint>");
+	if (hasDefinitions) {
+		bool hasStrings = options.generateToString || options.generateFromString;
+		if (options.generateReflection || options.generateDenseIndex || options.generateFlatMap) {
+			writer.addLine("#include <array>");
+		}
+		if (hasStrings || options.generateReflection || options.generateDenseIndex || options.generateValidation || options.generateBulkOperations
+			|| options.generateFlatMap || options.generateVkInterop) {
+			writer.addLine("#include <cstddef>");
+		}
+		if (options.generateHash) {
+			writer.addLine("#include <functional>");
+		}
+		if (options.generateFromString) {
+			writer.addLine("#include <optional>");
+		}
+		if (hasStrings) {
+			writer.addLine("#include <string_view>");
+		}
+		if (options.generateBitHelpers || options.operatorTemplates) {
+			writer.addLine("#include <type_traits>");
+		}
+		if (options.generateFlatMap) {
+			writer.addLine("#include <utility>");
+		}
+		if (options.generateBitHelpers || options.generateBulkOperations || options.generateVkInterop) {
+			writer.addLine("#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)");
+			if (options.generateBitHelpers) writer.addLine("#include <bit>");
+			if (options.generateBulkOperations || options.generateVkInterop) writer.addLine("#include <span>");
+			writer.addLine("#endif");
+		}
+		if (options.generateBulkOperations) {
+			//The bulk operations use the widest of the two available, defining VULKANENUMS_NO_SIMD turns both off
+			writer.addLine("#if !defined(VULKANENUMS_NO_SIMD) && defined(__AVX2__)");
+			writer.addLine("#define __VULKANENUMS_AVX2");
+			writer.addLine("#include <immintrin.h>");
+			writer.addLine("#elif !defined(VULKANENUMS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))");
+			writer.addLine("#define __VULKANENUMS_SSE2");
+			writer.addLine("#include <emmintrin.h>");
+			writer.addLine("#endif");
+		}
+		if (options.generateVkInterop) {
+			//Vulkan headers that were already included, e.g. through a loader, are used as they are.
+			//Defining VULKANENUMS_NO_VULKAN_HEADERS leaves out everything that needs them.
+			writer.addLine("#ifndef VULKANENUMS_NO_VULKAN_HEADERS");
+			writer.addLine("#if !defined(VULKAN_CORE_H_) && __has_include(<vulkan/vulkan_core.h>)");
+			writer.addLine("#include <vulkan/vulkan_core.h>");
+			writer.addLine("#endif");
+			writer.addLine("#ifdef VULKAN_CORE_H_");
+			writer.addLine("#define __VULKANENUMS_VULKAN_HEADERS");
+			writer.addLine("#endif");
+			writer.addLine("#endif");
+		}
+	}
+
+	writer.addLine("#ifdef _MSC_VER");
+	writer.addLine("#pragma warning( disable : 4146 )"); //Disable sign on unsigned value warnings (triggered on "-1U")
+	writer.addLine("#endif");
+}
+
+//Include guard, includes and namespace opener shared by all generated headers.
+//Headers that only declare enums don't need the includes of the definitions.
+static void writeHeaderBegin(CodeWriter& writer, std::string_view guardName, const ParsingOptions& options, bool hasDefinitions = true)
+{
+	writer.addLine("#ifndef ", guardName);
+	writer.addLine("#define ", guardName);
+
+	writeIncludes(writer, options, hasDefinitions);
 	//namespace opener
 	if (options.useNamespaces) {
-		addLine(outStream, "namespace " + options.namespaceName + " {");
-		++indentationLevel;
-	}
-
-	for (const auto& enumPair : enumMap) {
-		const VulkanEnum& enumValue = enumPair.second;
-		if (enumValue.isIncluded) {
-
-			std::string baseType;
-			switch (enumValue.type) {
-			case VulkanEnumType::Enum:
-				baseType = " : int32_t";
-				break;
-			case VulkanEnumType::Bitmask:
-				baseType = " : uint32_t";
-				break;
-			case VulkanEnumType::Bitmask64:
-				baseType = " : uint64_t";
-				break;
-			}
+		writer.addLine("namespace ", options.namespaceName, " {");
+		writer.indent();
+	}
+	if (hasDefinitions) {
+		writeSupportCode(writer, options);
+	}
+}
+
+//Closes the namespace and include guard. The std::hash specializations of enums have to be written in between.
+static void writeHeaderEnd(CodeWriter& writer, const ParsingOptions& options, const std::vector<const VulkanEnum*>& enums)
+{
+	if (options.useNamespaces) {
+		writer.outdent();
+		writer.addLine("}");
+	}
+	if (options.generateHash) {
+		writeHashes(enums, writer, options);
+	}
+	writer.addLine("#endif");
+}
+
+//Location of one formatted enum in the buffer of the worker that formatted it
+struct EnumText
+{
+	unsigned int workerIndex;
+	size_t begin, end;
+};
+
+//Formats enums on jobCount threads. Every worker formats into its own writer. The text of each enum doesn't depend on which worker
+//produced it, so appending the texts in enum order gives the same output as a single-threaded run.
+static std::vector<EnumText> formatEnums(const std::vector<const VulkanEnum*>& enums, const ParsingOptions& options, unsigned int indentationLevel,
+										 unsigned int jobCount, std::vector<CodeWriter>& workerWriters)
+{
+	workerWriters = std::vector<CodeWriter>(jobCount ? jobCount : 1);
+	for (auto& workerWriter : workerWriters) {
+		workerWriter.setIndentationLevel(indentationLevel);
+	}
+	std::vector<EnumText> enumTexts = std::vector<EnumText>(enums.size());
+
+	parallelFor(enums.size(), static_cast<unsigned int>(workerWriters.size()), [&](unsigned int workerIndex, size_t enumIndex) {
+		CodeWriter& workerWriter = workerWriters[workerIndex];
+		size_t begin = workerWriter.size();
+		writeEnum(*enums[enumIndex], workerWriter, options);
+		enumTexts[enumIndex] = { workerIndex, begin, workerWriter.size() };
+	});
+	return enumTexts;
+}
+
+static void appendEnumText(CodeWriter& writer, const std::vector<CodeWriter>& workerWriters, const EnumText& enumText)
+{
+	writer.append(workerWriters[enumText.workerIndex].text().substr(enumText.begin, enumText.end - enumText.begin));
+}
+
+//Included enums in output order: registry order, or by name if options.sortEnums is set
+static std::vector<const VulkanEnum*> includedEnums(const EnumMap& enumMap, const ParsingOptions& options)
+{
+	std::vector<const VulkanEnum*> enums;
+	for (const VulkanEnum& vulkanEnum : enumMap) {
+		if (vulkanEnum.isIncluded) {
+			enums.push_back(&vulkanEnum);
+		}
+	}
+	if (options.sortEnums) {
+		//Stable, so enums whose names collide after processing keep their registry order
+		std::stable_sort(enums.begin(), enums.end(), [](const VulkanEnum* one, const VulkanEnum* other) {
+			return one->name < other->name;
+		});
+	}
+	return enums;
+}
+
+//Writes the definitions of enums at the current indentation level of writer
+static void writeEnumDefinitions(const std::vector<const VulkanEnum*>& enums, CodeWriter& writer, const ParsingOptions& options, unsigned int jobCount)
+{
+	if (jobCount <= 1) {
+		for (const VulkanEnum* vulkanEnum : enums) {
+			writeEnum(*vulkanEnum, writer, options);
+		}
+	}
+	else {
+		std::vector<CodeWriter> workerWriters;
+		std::vector<EnumText> enumTexts = formatEnums(enums, options, writer.indentationLevel(), jobCount, workerWriters);
+		for (auto& enumText : enumTexts) {
+			appendEnumText(writer, workerWriters, enumText);
+		}
+	}
+}
+
+void writeEnums(const EnumMap& enumMap, CodeWriter& writer, const ParsingOptions& options, unsigned int jobCount)
+{
+	std::vector<const VulkanEnum*> enums = includedEnums(enumMap, options);
+	writeHeaderBegin(writer, "__VULKANENUMS_HPP", options);
+	writeEnumDefinitions(enums, writer, options, jobCount);
+	writeHeaderEnd(writer, options, enums);
+}
+
+void writeModule(const EnumMap& enumMap, CodeWriter& writer, const ParsingOptions& options, unsigned int jobCount)
+{
+	//Includes have to go into the global module fragment
+	writer.addLine("module;");
+	writeIncludes(writer, options);
+	writer.addLine("export module VulkanEnums;");
+	//Exporting the block exports the enums as well as their operators
+	if (options.useNamespaces) {
+		writer.addLine("export namespace ", options.namespaceName, " {");
+	}
+	else {
+		writer.addLine("export {");
+	}
+	writer.indent();
+	writeSupportCode(writer, options);
+
+	std::vector<const VulkanEnum*> enums = includedEnums(enumMap, options);
+	writeEnumDefinitions(enums, writer, options, jobCount);
+
+	writer.outdent();
+	writer.addLine("}");
+	if (options.generateHash) {
+		writeHashes(enums, writer, options);
+	}
+}
+
+std::vector<GeneratedFile> writeSplitEnums(const Registry& registry, const EnumMap& enumMap, const ParsingOptions& options, unsigned int jobCount)
+{
+	std::vector<const VulkanEnum*> enums = includedEnums(enumMap, options);
+	std::vector<CodeWriter> workerWriters;
+	std::vector<EnumText> enumTexts = formatEnums(enums, options, options.useNamespaces ? 1 : 0, jobCount, workerWriters);
+
+	//Enums per group, indexed by the group's position in the registry (features first, then extensions)
+	std::vector<uint32_t> groupIndices = std::vector<uint32_t>(registry.symbols.size(), ~0U);
+	std::vector<std::string_view> groupNames;
+	for (auto* blocks : { &registry.features, &registry.extensions }) {
+		for (auto& block : *blocks) {
+			groupIndices[block.nameSymbol] = static_cast<uint32_t>(groupNames.size());
+			groupNames.push_back(block.name);
+		}
+	}
+	std::vector<std::vector<size_t>> groupEnums = std::vector<std::vector<size_t>>(groupNames.size());
+	for (size_t i = 0; i < enums.size(); ++i) {
+		groupEnums[groupIndices[enums[i]->group->nameSymbol]].push_back(i);
+	}
+
+	std::vector<GeneratedFile> files = std::vector<GeneratedFile>(2);
+	files[0].path = "VulkanEnums.hpp";
+	files[1].path = "VulkanEnumsFwd.hpp";
+	CodeWriter& umbrellaWriter = files[0].contents;
+	CodeWriter& forwardWriter = files[1].contents;
+
+	writeHeaderBegin(forwardWriter, "__VULKANENUMSFWD_HPP", options, false);
+	for (const VulkanEnum* vulkanEnum : enums) {
+		forwardWriter.addLine("enum class ", vulkanEnum->name, enumBaseType(vulkanEnum->type), ";");
+	}
+	writeHeaderEnd(forwardWriter, options, {});
+
+	umbrellaWriter.addLine("#ifndef __VULKANENUMS_HPP");
+	umbrellaWriter.addLine("#define __VULKANENUMS_HPP");
+
+	std::vector<GeneratedFile> groupFiles;
+	std::vector<const VulkanEnum*> groupEnumList;
+	std::string guardName;
+	for (size_t groupIndex = 0; groupIndex < groupNames.size(); ++groupIndex) {
+		if (groupEnums[groupIndex].empty()) continue;
+
+		GeneratedFile& groupFile = groupFiles.emplace_back();
+		groupFile.path.append("VulkanEnums/").append(groupNames[groupIndex]).append(".hpp");
+		umbrellaWriter.addLine("#include \"", groupFile.path, "\"");
+
+		guardName.assign("__VULKANENUMS_");
+		for (char character : groupNames[groupIndex]) {
+			guardName.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(character))));
+		}
+		guardName.append("_HPP");
+
+		writeHeaderBegin(groupFile.contents, guardName, options);
+		groupEnumList.clear();
+		for (size_t enumIndex : groupEnums[groupIndex]) {
+			appendEnumText(groupFile.contents, workerWriters, enumTexts[enumIndex]);
+			groupEnumList.push_back(enums[enumIndex]);
+		}
+		writeHeaderEnd(groupFile.contents, options, groupEnumList);
+	}
+	umbrellaWriter.addLine("#endif");
+
+	files.reserve(files.size() + groupFiles.size());
+	std::move(groupFiles.begin(), groupFiles.end(), std::back_inserter(files));
+	return files;
+}
+
+void writeEnum(const VulkanEnum& vulkanEnum, CodeWriter& writer, const ParsingOptions& options)
+{
+	writer.addLine("enum class ", vulkanEnum.name, enumBaseType(vulkanEnum.type), " {");
+	writer.indent();
 
-			addLine(outStream, "enum class " + enumValue.name + baseType + " {");
-			++indentationLevel;
+	const std::vector<VulkanEnumValue>& values = vulkanEnum.values();
+	const std::vector<VulkanEnumValue>& aliasValues = vulkanEnum.aliasValues();
+	for (size_t i = 0; i < values.size(); ++i) {
+		writeEnumValue(values[i], writer, i == (values.size() + aliasValues.size()) - 1);
+	}
+	for (size_t i = 0; i < aliasValues.size(); ++i) {
+		writeEnumValue(aliasValues[i], writer, i == aliasValues.size() - 1);
+	}
+	if (!values.size()) {
+		writer.addLine("//Placeholder for an empty enum in the spec (empty enums are ill-formed in C++). Will be removed once the enum gets values.");
+		writer.addLine("Empty");
+	}
+
+	writer.outdent();
+	writer.addLine("};");
+
+	//Bitmask enums only opt in to the shared operator templates
+	if (vulkanEnum.type != VulkanEnumType::Enum && options.operatorTemplates) {
+		writer.addLine("template<> struct IsBitmaskEnum<", vulkanEnum.name, "> : std::true_type {};");
+	}
+	//Add logical operations for bitmask types
+	else if (vulkanEnum.type != VulkanEnumType::Enum) {
+		bool is64Bit = vulkanEnum.type == VulkanEnumType::Bitmask64;
+
+		writer.addLine("");
+		addEnumOperator(writer, vulkanEnum.name, "|", is64Bit);
+		addEnumOperator(writer, vulkanEnum.name, "&", is64Bit);
+		addEnumOperator(writer, vulkanEnum.name, "^", is64Bit);
+
+		//NOT (~) operator
+		writer.addLine("inline ", vulkanEnum.name, " operator~(", vulkanEnum.name, " obj) {");
+		writer.indent();
+
+		if(is64Bit)
+			writer.addLine("return static_cast<", vulkanEnum.name, ">(~static_cast<uint64_t>(obj));");
+		else
+			writer.addLine("return static_cast<", vulkanEnum.name, ">(~static_cast<uint32_t>(obj));");
+
+		writer.outdent();
+		writer.addLine("}");
+		if (options.generateBitHelpers) {
+			writer.addLine("template<> struct IsBitmaskEnum<", vulkanEnum.name, "> : std::true_type {};");
+		}
+	}
+
+	if (options.generateToString) {
+		writeToString(vulkanEnum, writer);
+	}
+	if (options.generateFromString) {
+		writeFromString(vulkanEnum, writer);
+	}
+	if (options.generateReflection) {
+		writeReflection(vulkanEnum, writer);
+	}
+	if (options.generateDenseIndex) {
+		writeDenseIndex(vulkanEnum, writer);
+	}
+	if (options.generateValidation) {
+		writeValidation(vulkanEnum, writer, options.generateDenseIndex);
+	}
+	if (options.generateBulkOperations && vulkanEnum.type == VulkanEnumType::Enum) {
+		writeBulkOperations(vulkanEnum, writer);
+	}
+	if (options.generateFlatMap && vulkanEnum.type == VulkanEnumType::Enum) {
+		writeFlatMapCapacity(vulkanEnum, writer, options.generateDenseIndex);
+	}
+	if (options.generateVkInterop) {
+		writeVkInterop(vulkanEnum, writer);
+	}
+}
+
+//Writes numbers as the entries of a table initializer, 16 per line
+static void writeTableEntries(CodeWriter& writer, const std::vector<uint64_t>& entries, bool isSigned, std::string_view suffix)
+{
+	constexpr size_t entriesPerLine = 16;
+	std::string line;
+	char digits[24];
+	for (size_t i = 0; i < entries.size(); ++i) {
+		std::to_chars_result result = isSigned ? std::to_chars(digits, digits + sizeof(digits), static_cast<int64_t>(entries[i]))
+											   : std::to_chars(digits, digits + sizeof(digits), entries[i]);
+		line.append(digits, result.ptr).append(suffix);
+		if (i + 1 != entries.size()) line.append(", ");
+		if ((i + 1) % entriesPerLine == 0 || i + 1 == entries.size()) {
+			if (line.back() == ' ') line.pop_back();
+			writer.addLine(line);
+			line.clear();
+		}
+	}
+}
+
+//Writes the string table <tableName>s, all names back to back, and the offset table <tableName>Offsets,
+//which has one more entry than names. Offsets are 16-bit unless the names are longer than 64 KiB.
+static void writeStringTable(CodeWriter& writer, std::string_view tableName, const std::vector<std::string_view>& names)
+{
+	std::vector<uint64_t> offsets;
+	offsets.reserve(names.size() + 1);
+	offsets.push_back(0);
+	for (std::string_view name : names) {
+		offsets.push_back(offsets.back() + name.size());
+	}
+	std::string_view offsetType = offsets.back() <= 0xFFFF ? "uint16_t" : "uint32_t";
 
-			const std::vector<VulkanEnumValue>& values = enumValue.values();
-			const std::vector<VulkanEnumValue>& aliasValues = enumValue.aliasValues();
-			for (size_t i = 0; i < values.size(); ++i) {
-				writeEnumValue(values[i], outStream, i == (values.size() + aliasValues.size()) - 1);
+	//One literal per name, long concatenations are fine but single long literals aren't for some compilers
+	writer.addLine("inline constexpr char ", tableName, "s[] =");
+	writer.indent();
+	size_t lastName = names.size();
+	for (size_t i = 0; i < names.size(); ++i) {
+		if (!names[i].empty()) lastName = i;
+	}
+	if (lastName == names.size()) {
+		writer.addLine("\"\";");
+	}
+	for (size_t i = 0; i < names.size(); ++i) {
+		if (!names[i].empty()) {
+			writer.addLine("\"", names[i], i == lastName ? "\";" : "\"");
+		}
+	}
+	writer.outdent();
+	writer.addLine("inline constexpr ", offsetType, " ", tableName, "Offsets[] = {");
+	writer.indent();
+	writeTableEntries(writer, offsets, false, "");
+	writer.outdent();
+	writer.addLine("};");
+}
+
+void writeToString(const VulkanEnum& vulkanEnum, CodeWriter& writer)
+{
+	writer.addLine("");
+	std::vector<const VulkanEnumValue*> values = sortedNumericValues(vulkanEnum);
+	if (values.empty()) {
+		writer.addLine("constexpr std::string_view toString(", vulkanEnum.name, ") {");
+		writer.indent();
+		writer.addLine("return std::string_view();");
+		writer.outdent();
+		writer.addLine("}");
+		return;
+	}
+
+	bool isSigned = vulkanEnum.type == VulkanEnumType::Enum;
+	bool is64Bit = vulkanEnum.type == VulkanEnumType::Bitmask64;
+	std::string_view underlyingType = isSigned ? "int32_t" : (is64Bit ? "uint64_t" : "uint32_t");
+
+	//Values are sorted in the underlying type, so the difference is the range in both signed and unsigned enums.
+	//Tables covering the whole range are indexed by value - first value, with an empty name for every gap, others are searched.
+	uint64_t firstValue = static_cast<uint64_t>(values.front()->numericValue);
+	uint64_t valueRange = static_cast<uint64_t>(values.back()->numericValue) - firstValue;
+	bool isDense = valueRange < 2 * values.size();
+
+	std::vector<std::string_view> names;
+	std::vector<uint64_t> keys;
+	if (isDense) {
+		names.resize(valueRange + 1);
+		for (const VulkanEnumValue* value : values) {
+			names[static_cast<uint64_t>(value->numericValue) - firstValue] = value->name;
+		}
+	}
+	else {
+		for (const VulkanEnumValue* value : values) {
+			names.push_back(value->name);
+			keys.push_back(static_cast<uint64_t>(value->numericValue));
+		}
+	}
+	std::string_view enumName = vulkanEnum.name;
+	writer.addLine("namespace VulkanEnumsDetail {");
+	writer.indent();
+	writeStringTable(writer, std::string(enumName).append("Name"), names);
+	if (!isDense) {
+		writer.addLine("inline constexpr ", underlyingType, " ", enumName, "Values[] = {");
+		writer.indent();
+		writeTableEntries(writer, keys, isSigned, is64Bit ? "ULL" : "");
+		writer.outdent();
+		writer.addLine("};");
+	}
+	writer.outdent();
+	writer.addLine("}");
+
+	writer.addLine("constexpr std::string_view toString(", enumName, " value) {");
+	writer.indent();
+	if (isDense) {
+		int64_t signedFirstValue = static_cast<int64_t>(firstValue);
+		if (isSigned) {
+			std::string_view sign = signedFirstValue < 0 ? " + " : " - ";
+			uint64_t magnitude = signedFirstValue < 0 ? 0 - firstValue : firstValue;
+			if (magnitude) {
+				writer.addLine("int64_t index = static_cast<int64_t>(value)", sign, magnitude, ";");
+			}
+			else {
+				writer.addLine("int64_t index = static_cast<int64_t>(value);");
 			}
-			for (size_t i = 0; i < aliasValues.size(); ++i) {
-				writeEnumValue(aliasValues[i], outStream, i == aliasValues.size() - 1);
+			writer.addLine("if (index < 0 || index > ", valueRange, ") return std::string_view();");
+		}
+		else {
+			if (firstValue) {
+				writer.addLine("uint64_t index = static_cast<uint64_t>(value) - ", firstValue, "ULL;");
 			}
-			if (!values.size()) {
-				addLine(outStream, "//Placeholder for an empty enum in the spec (empty enums are ill-formed in C++). Will be removed once the enum gets values.");
-				addLine(outStream, "Empty");
+			else {
+				writer.addLine("uint64_t index = static_cast<uint64_t>(value);");
 			}
+			writer.addLine("if (index > ", valueRange, ") return std::string_view();");
+		}
+		writer.addLine("return VulkanEnumsDetail::tableString(VulkanEnumsDetail::", enumName, "Names, VulkanEnumsDetail::", enumName,
+					   "NameOffsets, static_cast<size_t>(index));");
+	}
+	else {
+		writer.addLine("size_t index = VulkanEnumsDetail::findSortedKey(VulkanEnumsDetail::", enumName, "Values, ", keys.size(),
+					   ", static_cast<", underlyingType, ">(value));");
+		writer.addLine("if (index == ", keys.size(), ") return std::string_view();");
+		writer.addLine("return VulkanEnumsDetail::tableString(VulkanEnumsDetail::", enumName, "Names, VulkanEnumsDetail::", enumName,
+					   "NameOffsets, index);");
+	}
+	writer.outdent();
+	writer.addLine("}");
+}
 
-			--indentationLevel;
-			addLine(outStream, "};");
+//Has to match perfectHashSlot in the generated support code
+static size_t perfectHashSlot(uint64_t hash, uint64_t displacement, size_t slotCount)
+{
+	uint64_t mixed = hash ^ (displacement * 0x9E3779B97F4A7C15ULL);
+	mixed ^= mixed >> 31;
+	mixed *= 0xBF58476D1CE4E5B9ULL;
+	mixed ^= mixed >> 29;
+	return static_cast<size_t>(mixed % slotCount);
+}
 
-			//Add logical operations for bitmask types
-			if (enumValue.type != VulkanEnumType::Enum) {
-				bool is64Bit = enumValue.type == VulkanEnumType::Bitmask64;
+//Hash and displace: keys are grouped into buckets by hash % bucket count, then for each bucket, largest first,
+//the smallest displacement is searched that moves all of its keys into free slots. Returns false if a bucket doesn't fit.
+static bool buildPerfectHash(const std::vector<uint64_t>& hashes, size_t slotCount, std::vector<uint64_t>& displacements,
+							 std::vector<size_t>& slotKeys)
+{
+	size_t bucketCount = displacements.size();
+	std::vector<std::vector<size_t>> buckets = std::vector<std::vector<size_t>>(bucketCount);
+	for (size_t i = 0; i < hashes.size(); ++i) {
+		buckets[hashes[i] % bucketCount].push_back(i);
+	}
+	std::vector<size_t> bucketOrder = std::vector<size_t>(bucketCount);
+	for (size_t i = 0; i < bucketCount; ++i) {
+		bucketOrder[i] = i;
+	}
+	std::stable_sort(bucketOrder.begin(), bucketOrder.end(),
+					 [&buckets](size_t first, size_t second) { return buckets[first].size() > buckets[second].size(); });
 
-				addLine(outStream, "");
-				addEnumOperator(outStream, enumValue.name, "|", is64Bit);
-				addEnumOperator(outStream, enumValue.name, "&", is64Bit);
-				addEnumOperator(outStream, enumValue.name, "^", is64Bit);
+	slotKeys.assign(slotCount, hashes.size());
+	std::vector<size_t> bucketSlots;
+	for (size_t bucketIndex : bucketOrder) {
+		const std::vector<size_t>& bucket = buckets[bucketIndex];
+		if (bucket.empty()) break;
 
-				//NOT (~) operator
-				addLine(outStream, "inline " + enumValue.name + " operator~(" + enumValue.name + " obj) {");
-				++indentationLevel;
+		bool isPlaced = false;
+		for (uint64_t displacement = 0; displacement <= 0xFFFF && !isPlaced; ++displacement) {
+			bucketSlots.clear();
+			isPlaced = true;
+			for (size_t key : bucket) {
+				size_t slot = perfectHashSlot(hashes[key], displacement, slotCount);
+				if (slotKeys[slot] != hashes.size() || std::find(bucketSlots.begin(), bucketSlots.end(), slot) != bucketSlots.end()) {
+					isPlaced = false;
+					break;
+				}
+				bucketSlots.push_back(slot);
+			}
+			if (isPlaced) {
+				displacements[bucketIndex] = displacement;
+				for (size_t i = 0; i < bucket.size(); ++i) {
+					slotKeys[bucketSlots[i]] = bucket[i];
+				}
+			}
+		}
+		if (!isPlaced) return false;
+	}
+	return true;
+}
+
+void writeFromString(const VulkanEnum& vulkanEnum, CodeWriter& writer)
+{
+	std::string_view enumName = vulkanEnum.name;
+	writer.addLine("");
+
+	//Aliases are names of their own, but enumerators that are only emitted with their old name are not
+	std::vector<std::string_view> keys;
+	std::unordered_set<std::string_view> seenKeys;
+	for (auto& value : vulkanEnum.values()) {
+		if (!value.name.empty() && seenKeys.insert(value.name).second) keys.push_back(value.name);
+	}
+	for (auto& value : vulkanEnum.aliasValues()) {
+		if (!value.name.empty() && value.name != value.alias && seenKeys.insert(value.name).second) keys.push_back(value.name);
+	}
+
+	if (keys.empty()) {
+		writer.addLine("template<>");
+		writer.addLine("constexpr std::optional<", enumName, "> fromString<", enumName, ">(std::string_view) {");
+		writer.indent();
+		writer.addLine("return std::nullopt;");
+		writer.outdent();
+		writer.addLine("}");
+		return;
+	}
+
+	std::vector<uint64_t> hashes;
+	hashes.reserve(keys.size());
+	for (std::string_view key : keys) {
+		hashes.push_back(hashString(key));
+	}
+	//Four keys per bucket on average keep the displacement table small, one more slot per eight keys if a bucket doesn't fit
+	std::vector<uint64_t> displacements = std::vector<uint64_t>((keys.size() + 3) / 4, 0);
+	std::vector<size_t> slotKeys;
+	size_t slotCount = keys.size();
+	while (!buildPerfectHash(hashes, slotCount, displacements, slotKeys)) {
+		slotCount += keys.size() / 8 + 1;
+	}
+
+	std::vector<std::string_view> slotNames = std::vector<std::string_view>(slotCount);
+	for (size_t i = 0; i < slotCount; ++i) {
+		if (slotKeys[i] != keys.size()) slotNames[i] = keys[slotKeys[i]];
+	}
+
+	writer.addLine("namespace VulkanEnumsDetail {");
+	writer.indent();
+	writeStringTable(writer, std::string(enumName).append("Key"), slotNames);
+	writer.addLine("inline constexpr ", enumName, " ", enumName, "KeyValues[] = {");
+	writer.indent();
+	for (size_t i = 0; i < slotCount; ++i) {
+		std::string_view separator = i + 1 == slotCount ? "" : ",";
+		if (slotNames[i].empty()) {
+			writer.addLine("static_cast<", enumName, ">(0)", separator);
+		}
+		else {
+			writer.addLine(enumName, "::", slotNames[i], separator);
+		}
+	}
+	writer.outdent();
+	writer.addLine("};");
+	writer.addLine("inline constexpr uint16_t ", enumName, "KeyDisplacements[] = {");
+	writer.indent();
+	writeTableEntries(writer, displacements, false, "");
+	writer.outdent();
+	writer.addLine("};");
+	writer.outdent();
+	writer.addLine("}");
+
+	writer.addLine("template<>");
+	writer.addLine("constexpr std::optional<", enumName, "> fromString<", enumName, ">(std::string_view name) {");
+	writer.indent();
+	writer.addLine("uint64_t hash = VulkanEnumsDetail::nameHash(name);");
+	writer.addLine("size_t slot = VulkanEnumsDetail::perfectHashSlot(hash, VulkanEnumsDetail::", enumName, "KeyDisplacements[hash % ",
+				   displacements.size(), "], ", slotCount, ");");
+	writer.addLine("std::string_view key = VulkanEnumsDetail::tableString(VulkanEnumsDetail::", enumName, "Keys, VulkanEnumsDetail::",
+				   enumName, "KeyOffsets, slot);");
+	writer.addLine("if (key.empty() || key != name) return std::nullopt;");
+	writer.addLine("return VulkanEnumsDetail::", enumName, "KeyValues[slot];");
+	writer.outdent();
+	writer.addLine("}");
+}
+
+void writeReflection(const VulkanEnum& vulkanEnum, CodeWriter& writer)
+{
+	std::string_view enumName = vulkanEnum.name;
+	//Values that only repeat the number of an earlier value are aliases, even if vk.xml doesn't declare them as such
+	std::vector<const VulkanEnumValue*> values;
+	std::unordered_set<int64_t> seenValues;
+	for (auto& value : vulkanEnum.values()) {
+		if (value.name.empty() || value.name == value.alias) continue;
+		if (value.hasNumericValue && !seenValues.insert(value.numericValue).second) continue;
+		values.push_back(&value);
+	}
+	std::vector<const VulkanEnumValue*> sortedValues = sortedNumericValues(vulkanEnum);
+	//Ranges of the underlying type never overflow, as for toString
+	bool isContiguous = !sortedValues.empty() && sortedValues.size() == values.size() &&
+						static_cast<uint64_t>(sortedValues.back()->numericValue) - static_cast<uint64_t>(sortedValues.front()->numericValue) ==
+							sortedValues.size() - 1;
+
+	writer.addLine("");
+	writer.addLine("template<>");
+	writer.addLine("struct EnumReflection<", enumName, "> {");
+	writer.indent();
+	writer.addLine("static constexpr std::array<", enumName, ", ", values.size(), "> values = {");
+	writer.indent();
+	for (size_t i = 0; i < values.size(); ++i) {
+		writer.addLine(enumName, "::", values[i]->name, i + 1 == values.size() ? "" : ",");
+	}
+	writer.outdent();
+	writer.addLine("};");
+	writer.addLine("static constexpr size_t count = ", values.size(), ";");
+	if (sortedValues.empty()) {
+		writer.addLine("//Empty enums have neither a minimum nor a maximum");
+		writer.addLine("static constexpr ", enumName, " minValue = static_cast<", enumName, ">(0);");
+		writer.addLine("static constexpr ", enumName, " maxValue = static_cast<", enumName, ">(0);");
+	}
+	else {
+		writer.addLine("static constexpr ", enumName, " minValue = ", enumName, "::", sortedValues.front()->name, ";");
+		writer.addLine("static constexpr ", enumName, " maxValue = ", enumName, "::", sortedValues.back()->name, ";");
+	}
+	writer.addLine("//True if every number from minValue to maxValue is a value");
+	writer.addLine("static constexpr bool isContiguous = ", isContiguous ? "true" : "false", ";");
+	writer.outdent();
+	writer.addLine("};");
+}
+
+std::vector<size_t> valueRunStarts(const std::vector<const VulkanEnumValue*>& sortedValues)
+{
+	std::vector<size_t> runStarts;
+	for (size_t i = 0; i < sortedValues.size(); ++i) {
+		if (!i || static_cast<uint64_t>(sortedValues[i]->numericValue) - static_cast<uint64_t>(sortedValues[i - 1]->numericValue) != 1) {
+			runStarts.push_back(i);
+		}
+	}
+	runStarts.push_back(sortedValues.size());
+	return runStarts;
+}
+
+void writeDenseIndex(const VulkanEnum& vulkanEnum, CodeWriter& writer)
+{
+	std::string_view enumName = vulkanEnum.name;
+	std::string_view underlyingType = vulkanEnum.type == VulkanEnumType::Enum ? "int32_t" : (vulkanEnum.type == VulkanEnumType::Bitmask64 ? "uint64_t" : "uint32_t");
+	std::vector<const VulkanEnumValue*> values = sortedNumericValues(vulkanEnum);
+	std::vector<size_t> runStarts = valueRunStarts(values);
+	size_t runCount = runStarts.size() - 1;
+
+	writer.addLine("");
+	if (runCount > 1) {
+		writer.addLine("namespace VulkanEnumsDetail {");
+		writer.indent();
+		writer.addLine("inline constexpr ", enumName, " ", enumName, "RunFirsts[] = {");
+		writer.indent();
+		for (size_t i = 0; i < runCount; ++i) {
+			writer.addLine(enumName, "::", values[runStarts[i]]->name, i + 1 == runCount ? "" : ",");
+		}
+		writer.outdent();
+		writer.addLine("};");
+		writer.addLine("inline constexpr uint32_t ", enumName, "RunIndices[] = {");
+		writer.indent();
+		writeTableEntries(writer, std::vector<uint64_t>(runStarts.begin(), runStarts.end()), false, "");
+		writer.outdent();
+		writer.addLine("};");
+		writer.addLine("inline constexpr ", enumName, " ", enumName, "DenseValues[] = {");
+		writer.indent();
+		for (size_t i = 0; i < values.size(); ++i) {
+			writer.addLine(enumName, "::", values[i]->name, i + 1 == values.size() ? "" : ",");
+		}
+		writer.outdent();
+		writer.addLine("};");
+		writer.outdent();
+		writer.addLine("}");
+	}
 
-				if(is64Bit)
-					addLine(outStream, "return static_cast<" + enumValue.name + ">(~static_cast<uint64_t>(obj));");
-				else
-					addLine(outStream, "return static_cast<" + enumValue.name + ">(~static_cast<uint32_t>(obj));");
+	writer.addLine("template<>");
+	writer.addLine("inline constexpr size_t kDenseCount<", enumName, "> = ", values.size(), ";");
+	writer.addLine("//Position of value among all values in ascending order, kDenseCount if it isn't one of them");
+	writer.addLine("constexpr size_t toDenseIndex(", enumName, runCount ? " value" : "", ") {");
+	writer.indent();
+	if (!runCount) {
+		writer.addLine("return 0;");
+	}
+	else if (runCount == 1) {
+		//Casting both to uint64_t keeps the difference right for negative values
+		writer.addLine("uint64_t offset = static_cast<uint64_t>(value) - static_cast<uint64_t>(", enumName, "::", values.front()->name, ");");
+		writer.addLine("return offset < ", values.size(), " ? static_cast<size_t>(offset) : ", values.size(), ";");
+	}
+	else {
+		writer.addLine("size_t run = VulkanEnumsDetail::findRun(VulkanEnumsDetail::", enumName, "RunFirsts, ", runCount, ", value);");
+		writer.addLine("if (run == ", runCount, ") return ", values.size(), ";");
+		writer.addLine("uint64_t offset = static_cast<uint64_t>(value) - static_cast<uint64_t>(VulkanEnumsDetail::", enumName, "RunFirsts[run]);");
+		writer.addLine("uint32_t runIndex = VulkanEnumsDetail::", enumName, "RunIndices[run];");
+		writer.addLine("return offset < VulkanEnumsDetail::", enumName, "RunIndices[run + 1] - runIndex ? runIndex + static_cast<size_t>(offset) : ",
+					   values.size(), ";");
+	}
+	writer.outdent();
+	writer.addLine("}");
+
+	writer.addLine("template<>");
+	writer.addLine("constexpr ", enumName, " fromDenseIndex<", enumName, ">(size_t", runCount ? " index" : "", ") {");
+	writer.indent();
+	if (!runCount) {
+		writer.addLine("return static_cast<", enumName, ">(0);");
+	}
+	else if (runCount == 1) {
+		writer.addLine("return static_cast<", enumName, ">(static_cast<", underlyingType, ">(", enumName, "::", values.front()->name,
+					   ") + static_cast<", underlyingType, ">(index));");
+	}
+	else {
+		writer.addLine("return VulkanEnumsDetail::", enumName, "DenseValues[index];");
+	}
+	writer.outdent();
+	writer.addLine("}");
+}
+
+void writeValidation(const VulkanEnum& vulkanEnum, CodeWriter& writer, bool hasRunFirsts)
+{
+	std::string_view enumName = vulkanEnum.name;
+	std::vector<const VulkanEnumValue*> values = sortedNumericValues(vulkanEnum);
+	writer.addLine("");
+
+	if (vulkanEnum.type != VulkanEnumType::Enum) {
+		//Values with several bits are combinations of other bits or, like ShaderStageFlags::All, cover bits that aren't defined yet
+		uint64_t allBits = 0;
+		for (const VulkanEnumValue* value : values) {
+			uint64_t bits = static_cast<uint64_t>(value->numericValue);
+			if (bits && !(bits & (bits - 1))) allBits |= bits;
+		}
+		bool is64Bit = vulkanEnum.type == VulkanEnumType::Bitmask64;
+		std::string_view underlyingType = is64Bit ? "uint64_t" : "uint32_t";
+		char digits[24];
+		std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), allBits, 16);
+		writer.addLine("template<>");
+		writer.addLine("inline constexpr ", enumName, " kAllBits<", enumName, "> = static_cast<", enumName, ">(0x",
+					   std::string_view(digits, static_cast<size_t>(result.ptr - digits)), is64Bit ? "ULL" : "U", ");");
+		writer.addLine("constexpr bool hasOnlyKnownBits(", enumName, " flags) {");
+		writer.indent();
+		writer.addLine("return (static_cast<", underlyingType, ">(flags) & ~static_cast<", underlyingType, ">(kAllBits<", enumName, ">)) == 0;");
+		writer.outdent();
+		writer.addLine("}");
+		return;
+	}
 
-				--indentationLevel;
-				addLine(outStream, "}");
+	//Few runs are checked inline, the runs of enums with many extension values are searched
+	constexpr size_t maxInlineRunCount = 4;
+	std::vector<size_t> runStarts = valueRunStarts(values);
+	size_t runCount = runStarts.size() - 1;
+	if (runCount > maxInlineRunCount) {
+		writer.addLine("namespace VulkanEnumsDetail {");
+		writer.indent();
+		if (!hasRunFirsts) {
+			writer.addLine("inline constexpr ", enumName, " ", enumName, "RunFirsts[] = {");
+			writer.indent();
+			for (size_t i = 0; i < runCount; ++i) {
+				writer.addLine(enumName, "::", values[runStarts[i]]->name, i + 1 == runCount ? "" : ",");
 			}
+			writer.outdent();
+			writer.addLine("};");
 		}
+		writer.addLine("inline constexpr ", enumName, " ", enumName, "RunLasts[] = {");
+		writer.indent();
+		for (size_t i = 0; i < runCount; ++i) {
+			writer.addLine(enumName, "::", values[runStarts[i + 1] - 1]->name, i + 1 == runCount ? "" : ",");
+		}
+		writer.outdent();
+		writer.addLine("};");
+		writer.outdent();
+		writer.addLine("}");
 	}
 
-	if (options.useNamespaces) {
-		--indentationLevel;
-		addLine(outStream, "}");
+	writer.addLine("constexpr bool isValid(", enumName, runCount ? " value" : "", ") {");
+	writer.indent();
+	if (!runCount) {
+		writer.addLine("return false;");
+	}
+	else if (runCount > maxInlineRunCount) {
+		writer.addLine("size_t run = VulkanEnumsDetail::findRun(VulkanEnumsDetail::", enumName, "RunFirsts, ", runCount, ", value);");
+		writer.addLine("return run != ", runCount, " && !(VulkanEnumsDetail::", enumName, "RunLasts[run] < value);");
+	}
+	else {
+		//value - first wraps around for values before the run, so one unsigned compare checks both ends
+		for (size_t i = 0; i < runCount; ++i) {
+			const VulkanEnumValue* first = values[runStarts[i]];
+			std::string_view prefix = i ? "\t|| " : "return ";
+			std::string_view suffix = i + 1 == runCount ? ";" : "";
+			writer.addLine(prefix, "static_cast<uint64_t>(value) - static_cast<uint64_t>(", enumName, "::", first->name, ") <= ",
+						   runStarts[i + 1] - runStarts[i] - 1, suffix);
+		}
+	}
+	writer.outdent();
+	writer.addLine("}");
+}
+
+void writeBulkOperations(const VulkanEnum& vulkanEnum, CodeWriter& writer)
+{
+	std::string_view enumName = vulkanEnum.name;
+	std::vector<const VulkanEnumValue*> values = sortedNumericValues(vulkanEnum);
+	std::vector<size_t> runStarts = valueRunStarts(values);
+	size_t runCount = runStarts.size() - 1;
+	//Empty enums still need one entry, arrays can't be empty
+	std::vector<uint64_t> firsts, lengths, indices;
+	for (size_t i = 0; i < runCount; ++i) {
+		firsts.push_back(static_cast<uint64_t>(values[runStarts[i]]->numericValue));
+		lengths.push_back(runStarts[i + 1] - runStarts[i]);
+		indices.push_back(runStarts[i]);
+	}
+	if (!runCount) {
+		firsts.push_back(0);
+		lengths.push_back(0);
+		indices.push_back(0);
+	}
+
+	writer.addLine("");
+	writer.addLine("namespace VulkanEnumsDetail {");
+	writer.indent();
+	writer.addLine("inline constexpr int32_t ", enumName, "BulkRunFirsts[] = {");
+	writer.indent();
+	writeTableEntries(writer, firsts, true, "");
+	writer.outdent();
+	writer.addLine("};");
+	writer.addLine("inline constexpr uint32_t ", enumName, "BulkRunLengths[] = {");
+	writer.indent();
+	writeTableEntries(writer, lengths, false, "");
+	writer.outdent();
+	writer.addLine("};");
+	writer.addLine("inline constexpr uint32_t ", enumName, "BulkRunIndices[] = {");
+	writer.indent();
+	writeTableEntries(writer, indices, false, "");
+	writer.outdent();
+	writer.addLine("};");
+	//Static member arrays would be simpler, but GCC doesn't emit them for importers of the module
+	writer.addLine("template<>");
+	writer.addLine("struct EnumRuns<", enumName, "> {");
+	writer.indent();
+	writer.addLine("static constexpr size_t runCount = ", runCount, ";");
+	writer.addLine("static constexpr uint32_t valueCount = ", values.size(), ";");
+	writer.addLine("static constexpr const int32_t* firsts = ", enumName, "BulkRunFirsts;");
+	writer.addLine("static constexpr const uint32_t* lengths = ", enumName, "BulkRunLengths;");
+	writer.addLine("static constexpr const uint32_t* indices = ", enumName, "BulkRunIndices;");
+	writer.outdent();
+	writer.addLine("};");
+	writer.outdent();
+	writer.addLine("}");
+}
+
+void writeFlatMapCapacity(const VulkanEnum& vulkanEnum, CodeWriter& writer, bool usesDenseIndex)
+{
+	size_t valueCount = sortedNumericValues(vulkanEnum).size();
+	//Dense indices need one slot more than there are values for the index of everything else,
+	//hashed keys are kept at most half full so probe sequences stay short
+	size_t capacity = usesDenseIndex ? valueCount + 1 : std::max(valueCount * 2, size_t(1));
+	writer.addLine("template<>");
+	writer.addLine("inline constexpr size_t kFlatMapCapacity<", vulkanEnum.name, "> = ", capacity, ";");
+}
+
+//Macro vulkan_core.h defines if it contains block. Features and extensions are named after it, e.g. VK_VERSION_1_3.
+static std::string vulkanHeaderMacro(const RegistryBlock& block)
+{
+	return std::string(block.name);
+}
+
+void writeVkInterop(const VulkanEnum& vulkanEnum, CodeWriter& writer)
+{
+	std::string_view enumName = vulkanEnum.name;
+	//Bitmask enums correspond to the Flags typedef, like their names
+	std::string vulkanName = "::";
+	vulkanName.append(vulkanEnum.originalName);
+	size_t flagBitsIndex = vulkanName.find("FlagBits");
+	if (vulkanEnum.type != VulkanEnumType::Enum && flagBitsIndex != std::string::npos) {
+		vulkanName.replace(flagBitsIndex, 8, "Flags");
+	}
+	std::string enumMacro = vulkanEnum.group ? vulkanHeaderMacro(*vulkanEnum.group) : std::string();
+
+	writer.addLine("");
+	writer.addLine("#ifdef __VULKANENUMS_VULKAN_HEADERS");
+	if (!enumMacro.empty()) writer.addLine("#ifdef ", enumMacro);
+	writer.addLine("template<> struct VulkanType<", enumName, "> { using Type = ", vulkanName, "; };");
+	writer.addLine("static_assert(sizeof(", enumName, ") == sizeof(", vulkanName, ") && alignof(", enumName, ") == alignof(", vulkanName, "));");
+	//Values added by other features or extensions are only compared if the header contains them as well
+	std::string valueMacro, openMacro;
+	for (const VulkanEnumValue& value : vulkanEnum.values()) {
+		valueMacro = value.addedBy ? vulkanHeaderMacro(*value.addedBy) : std::string();
+		if (valueMacro == enumMacro) valueMacro.clear();
+		if (valueMacro != openMacro) {
+			if (!openMacro.empty()) writer.addLine("#endif");
+			if (!valueMacro.empty()) writer.addLine("#ifdef ", valueMacro);
+			openMacro = valueMacro;
+		}
+		if (vulkanEnum.type == VulkanEnumType::Enum) {
+			writer.addLine("static_assert(toVk(", enumName, "::", value.name, ") == ::", value.originalName, ");");
+		}
+		else {
+			writer.addLine("static_assert(toVk(", enumName, "::", value.name, ") == static_cast<", vulkanName, ">(::", value.originalName, "));");
+		}
+	}
+	if (!openMacro.empty()) writer.addLine("#endif");
+	if (!enumMacro.empty()) writer.addLine("#endif");
+	writer.addLine("#endif");
+}
+
+void writeHashes(const std::vector<const VulkanEnum*>& enums, CodeWriter& writer, const ParsingOptions& options)
+{
+	if (enums.empty()) return;
+	std::string qualifier = options.useNamespaces ? options.namespaceName + "::" : std::string();
+	std::string qualifiedName;
+	writer.addLine("namespace std {");
+	writer.indent();
+	for (const VulkanEnum* vulkanEnum : enums) {
+		qualifiedName.assign(qualifier).append(vulkanEnum->name);
+		writer.addLine("template<> struct hash<", qualifiedName, "> {");
+		writer.indent();
+		//Dense indices of values are unique and small, so they're already a perfect hash
+		if (options.generateDenseIndex && vulkanEnum->type == VulkanEnumType::Enum) {
+			writer.addLine("constexpr size_t operator()(", qualifiedName, " value) const noexcept { return ", qualifier, "toDenseIndex(value); }");
+		}
+		else {
+			writer.addLine("constexpr size_t operator()(", qualifiedName, " value) const noexcept { return static_cast<size_t>(value); }");
+		}
+		writer.outdent();
+		writer.addLine("};");
 	}
-	addLine(outStream, "#endif");
+	writer.outdent();
+	writer.addLine("}");
 }
 
-void writeEnumValue(const VulkanEnumValue& enumValue, std::ostream& outStream, bool isLastValue)
+void writeEnumValue(const VulkanEnumValue& enumValue, CodeWriter& writer, bool isLastValue)
 {
 	//Explicitly filter out aliases with the same name, avoiding redefinitions
-	if(enumValue.name == enumValue.value) return;
+	if(enumValue.name == enumValue.alias) return;
 
 	if (!enumValue.comment.empty()) {
-		addLine(outStream, "//" + enumValue.comment);
+		writer.addLine("//", enumValue.comment);
 	}
 
-	std::string valueText;
-	if (enumValue.isBitpos) {
-		valueText = "1ULL << " + enumValue.value;
+	std::string_view bitposPrefix = enumValue.isBitpos ? "1ULL << " : "";
+	std::string_view sign = enumValue.isNegative ? "-" : "";
+	std::string_view separator = isLastValue ? "" : ", ";
+	if (enumValue.isExtensionValue) {
+		writer.addLine(enumValue.name, " = ", bitposPrefix, sign, enumValue.extensionValue, separator);
+	}
+	else if (!enumValue.alias.empty()) {
+		writer.addLine(enumValue.name, " = ", bitposPrefix, sign, enumValue.alias, separator);
 	}
 	else {
-		valueText = enumValue.value;
+		writer.addLine(enumValue.name, " = ", bitposPrefix, sign, enumValue.value, separator);
 	}
-	addLine(outStream, enumValue.name + " = " + valueText + (isLastValue ? "" : ", "));
 }
 
-VulkanEnum parseBasicEnumNode(const XMLElement* node, const ParsingOptions& options)
+VulkanEnum parseBasicEnumNode(const RegistryEnum& node)
 {
 	VulkanEnum result;
 
-	const char* nameC = node->Attribute("name");
-	if (nameC) {
-		result.name = nameC;
-		result.originalName = nameC;
-	}
-	processName(options, result.name);
+	result.originalName = node.name;
 
-	const char* type = node->Attribute("type");
-	if (type && !strcmp(type, "bitmask")) {
-		const char* bitwidth = node->Attribute("bitwidth");
-		if (bitwidth && !strcmp(bitwidth, "64")) {
+	if (node.type == "bitmask") {
+		if (node.bitwidth == "64") {
 			result.type = VulkanEnumType::Bitmask64;
 		}
 		else {
@@ -236,94 +2083,114 @@ VulkanEnum parseBasicEnumNode(const XMLElement* node, const ParsingOptions& opti
 		}
 	}
 
-	const XMLElement* valueNode = node->FirstChildElement("enum");
-	while (valueNode)
-	{
-		parseValueNode(valueNode, result, options);
-		valueNode = valueNode->NextSiblingElement("enum");
+	for (auto& value : node.values) {
+		parseValueNode(value, nullptr, result);
 	}
 	return result;
 }
 
-void parseExtensionEnumNode(const XMLElement* node, const ParsingOptions& options, EnumMap& enums)
+void parseExtensionEnumNode(const RegistryBlock& node, EnumMap& enums)
 {
-	const XMLElement* requireNode = node->FirstChildElement("require");
-	while (requireNode)
-	{
-		const XMLElement* enumNode = requireNode->FirstChildElement("enum");
-		while (enumNode)
-		{
-			const char* extendsName = enumNode->Attribute("extends");
-			if (extendsName) {
-				parseValueNode(enumNode, enums[extendsName], options);
-			}
-			enumNode = enumNode->NextSiblingElement("enum");
-		}
-		const XMLElement* typeNode = requireNode->FirstChildElement("type");
-		while (typeNode)
-		{
-			const char* referencedName = typeNode->Attribute("name");
-			if (referencedName) {
-				auto enumIterator = enums.find(referencedName);
-				if (enumIterator != enums.end()) {
-					enumIterator->second.isIncluded = true;
-				}
+	for (auto& value : node.values) {
+		parseValueNode(value, &node, enums[value.extendsSymbol]);
+	}
+	for (Symbol referencedName : node.types) {
+		VulkanEnum* referencedEnum = enums.find(referencedName);
+		if (referencedEnum) {
+			referencedEnum->isIncluded = true;
+			if (!referencedEnum->group) {
+				referencedEnum->group = &node;
 			}
-			typeNode = typeNode->NextSiblingElement("type");
 		}
-		requireNode = requireNode->NextSiblingElement("require");
 	}
 }
 
-void parseValueNode(const XMLElement* valueNode, VulkanEnum& vulkanEnum, const ParsingOptions& options)
+//Integer prefix of text, or 0 if it doesn't start with a number (same as atoi)
+static int parseInt(std::string_view text)
 {
-	VulkanEnumValue enumValue;
-	const XMLNode* parent = valueNode->Parent();
-	const XMLNode* grandparent = parent ? parent->Parent() : nullptr;
-
-	std::string valueName;
-	const char* valueNameC = valueNode->Attribute("name");
-	const char* valueC = valueNode->Attribute("value");
-	const char* bitposC = valueNode->Attribute("bitpos");
-	const char* aliasC = valueNode->Attribute("alias");
-	const char* offsetC = valueNode->Attribute("offset");
-	const char* extNumberC = grandparent ? grandparent->ToElement()->Attribute("number") : nullptr;
-	const char* commentC = valueNode->Attribute("comment");
-	const char* dirC = valueNode->Attribute("dir");
+	int result = 0;
+	std::from_chars(text.data(), text.data() + text.length(), result);
+	return result;
+}
 
-	if (commentC) {
-		enumValue.comment = commentC;
+//Parses a decimal or hexadecimal (0x) integer with an optional '-', the whole text has to be the number
+static bool parseIntegerValue(std::string_view text, int64_t& result)
+{
+	bool isNegative = !text.empty() && text[0] == '-';
+	if (isNegative) text.remove_prefix(1);
+	int base = 10;
+	if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+		text.remove_prefix(2);
+		base = 16;
 	}
+	uint64_t magnitude = 0;
+	std::from_chars_result parseResult = std::from_chars(text.data(), text.data() + text.size(), magnitude, base);
+	if (text.empty() || parseResult.ec != std::errc() || parseResult.ptr != text.data() + text.size()) return false;
+	result = static_cast<int64_t>(isNegative ? 0 - magnitude : magnitude);
+	return true;
+}
 
-	if (valueNameC) {
-		valueName = valueNameC;
-		enumValue.name = valueName;
-		processValueName(options, enumValue.name, vulkanEnum.originalName);
+void parseValueNode(const RegistryValue& valueNode, const RegistryBlock* block, VulkanEnum& vulkanEnum)
+{
+	VulkanEnumValue enumValue;
+	enumValue.originalName = valueNode.name;
+	enumValue.addedBy = block;
+	std::string_view extNumber = block ? block->number : std::string_view();
+	enumValue.comment = valueNode.comment;
+	enumValue.isNegative = !valueNode.dir.empty() && valueNode.dir[0] == '-';
+
+	//Values promoted to core or from other extensions name the extension that defined them
+	if (!valueNode.extnumber.empty()) {
+		extNumber = valueNode.extnumber;
 	}
 
-	if (offsetC && extNumberC) {
-		int offset = atoi(offsetC);
-		int extNumber = atoi(extNumberC);
-		enumValue.value = std::to_string(1000000000 + (extNumber - 1) * 1000 + offset);
+	if (!valueNode.offset.empty() && !extNumber.empty()) {
+		int offset = parseInt(valueNode.offset);
+		int extNumberValue = parseInt(extNumber);
+		enumValue.extensionValue = 1000000000 + (extNumberValue - 1) * 1000 + offset;
+		enumValue.isExtensionValue = true;
+		enumValue.numericValue = enumValue.isNegative ? -enumValue.extensionValue : enumValue.extensionValue;
+		enumValue.hasNumericValue = true;
 	}
-	else if (aliasC) {
-		enumValue.value = aliasC;
-		processValueName(options, enumValue.value, vulkanEnum.originalName);
-		vulkanEnum.addAliasEnumValue(valueName, enumValue);
+	else if (!valueNode.alias.empty()) {
+		enumValue.originalAlias = valueNode.alias;
+		vulkanEnum.addAliasEnumValue(valueNode.nameSymbol, std::move(enumValue));
+		return;
 	}
-	else if (bitposC) {
-		enumValue.value = bitposC;
+	else if (!valueNode.bitpos.empty()) {
+		enumValue.value = valueNode.bitpos;
 		enumValue.isBitpos = true;
+		int64_t bitpos;
+		if (parseIntegerValue(valueNode.bitpos, bitpos) && bitpos >= 0 && bitpos < 64) {
+			enumValue.numericValue = static_cast<int64_t>(1ULL << bitpos);
+			enumValue.hasNumericValue = true;
+		}
 	}
-	else if (valueC) {
-		enumValue.value = valueC;
+	else {
+		enumValue.value = valueNode.value;
+		enumValue.hasNumericValue = parseIntegerValue(valueNode.value, enumValue.numericValue);
 	}
 
-	if (dirC && dirC[0] == '-') {
-		enumValue.value.insert(enumValue.value.begin(), '-');
-	}
-	vulkanEnum.addEnumValue(valueName, enumValue);
+	vulkanEnum.addEnumValue(valueNode.nameSymbol, std::move(enumValue));
+}
 
+std::vector<const VulkanEnumValue*> sortedNumericValues(const VulkanEnum& vulkanEnum)
+{
+	std::vector<const VulkanEnumValue*> sortedValues;
+	for (auto& value : vulkanEnum.values()) {
+		if (value.hasNumericValue) sortedValues.push_back(&value);
+	}
+	//Bitmasks have unsigned underlying types, so their order differs from the signed order for the highest bit
+	bool isUnsigned = vulkanEnum.type != VulkanEnumType::Enum;
+	auto isLess = [isUnsigned](const VulkanEnumValue* one, const VulkanEnumValue* other) {
+		if (isUnsigned) return static_cast<uint64_t>(one->numericValue) < static_cast<uint64_t>(other->numericValue);
+		return one->numericValue < other->numericValue;
+	};
+	std::stable_sort(sortedValues.begin(), sortedValues.end(), isLess);
+	sortedValues.erase(std::unique(sortedValues.begin(), sortedValues.end(), [](const VulkanEnumValue* one, const VulkanEnumValue* other) {
+		return one->numericValue == other->numericValue;
+	}), sortedValues.end());
+	return sortedValues;
 }
 
 void processName(const ParsingOptions& options, std::string& name)
@@ -341,13 +2208,15 @@ void processName(const ParsingOptions& options, std::string& name)
 	}
 }
 
-void processValueName(const ParsingOptions& options, std::string& valueName, const std::string& originalStructureName, bool allowLeadingDigits)
+void processValueName(const ParsingOptions& options, std::string& valueName, std::string_view originalStructureName, bool allowLeadingDigits)
 {
 	size_t prefixLength = valueName.find("VK_") == 0 ? 3 : 0;
 
 	if (options.removeStructureNames) {
-		//The original unprocessed name is needed
-		std::string structureName = structureNameToEnumValue(originalStructureName);
+		//The original unprocessed name is needed.
+		//The buffer is reused across calls so its capacity only needs to be allocated once per thread.
+		thread_local std::string structureName;
+		structureNameToEnumValue(originalStructureName, structureName);
 		// The extension tag will be removed separately in the value, 
 		// but it might interfere with values that start with the same letter as an extension tag
 		// (e.g. Error and EXT)
@@ -413,68 +2282,189 @@ void processValueName(const ParsingOptions& options, std::string& valueName, con
 	}
 }
 
-void includeExtensionDependencies(const XMLElement* extensionsNode, const std::string& extensionName, std::unordered_set<std::string>& dependencyNames)
+static bool parseDependsExpression(std::string_view expression, size_t& position, std::vector<std::string_view>& extensionNames);
+
+//Parses a name or parenthesized expression and appends the extensions it requires to extensionNames.
+//Returns true if core API versions alone fulfill it.
+static bool parseDependsPrimary(std::string_view expression, size_t& position, std::vector<std::string_view>& extensionNames)
 {
-	std::unordered_set<std::string> dependencies;
-	const XMLElement* extensionNode = extensionsNode->FirstChildElement("extension");
-	while (extensionNode)
+	if (position < expression.length() && expression[position] == '(') {
+		++position;
+		bool satisfiedByCore = parseDependsExpression(expression, position, extensionNames);
+		if (position < expression.length() && expression[position] == ')')
+			++position;
+		return satisfiedByCore;
+	}
+
+	size_t nameEnd = expression.find_first_of(",+()", position);
+	if (nameEnd == std::string_view::npos)
+		nameEnd = expression.length();
+
+	std::string_view name = expression.substr(position, nameEnd - position);
+	position = nameEnd;
+	if (name.find("VK_VERSION_") == 0 || name.find("VKSC_VERSION_") == 0) {
+		return true;
+	}
+	if (!name.empty()) {
+		extensionNames.push_back(name);
+	}
+	return false;
+}
+
+//Operators have equal precedence and are evaluated left to right, vk.xml parenthesizes mixed expressions.
+//An alternative (',') that core satisfies contributes no dependencies at all, all other
+//alternatives are kept conservatively since the graph has no notion of "one of".
+static bool parseDependsExpression(std::string_view expression, size_t& position, std::vector<std::string_view>& extensionNames)
+{
+	size_t firstName = extensionNames.size();
+	bool satisfiedByCore = parseDependsPrimary(expression, position, extensionNames);
+	while (position < expression.length() && (expression[position] == '+' || expression[position] == ','))
 	{
-		const char* name = extensionNode->Attribute("name");
-		if (name && extensionName == name) {
-			const char* dependenciesText = extensionNode->Attribute("requires");
-			if (dependenciesText) {
-				std::vector<std::string> dependencyExtensions = splitList(dependenciesText, ',');
-				dependencies.insert(dependencyExtensions.begin(), dependencyExtensions.end());
-			}
-			break;
+		bool isAnd = expression[position] == '+';
+		++position;
+		bool otherSatisfiedByCore = parseDependsPrimary(expression, position, extensionNames);
+
+		if (isAnd) {
+			satisfiedByCore = satisfiedByCore && otherSatisfiedByCore;
+		}
+		else {
+			satisfiedByCore = satisfiedByCore || otherSatisfiedByCore;
+		}
+		if (satisfiedByCore) {
+			extensionNames.resize(firstName);
 		}
-		extensionNode = extensionNode->NextSiblingElement("extension");
 	}
+	return satisfiedByCore;
+}
 
-	for (auto& dependency : dependencies) {
-		includeExtensionDependencies(extensionsNode, dependency, dependencies);
+void ExtensionGraph::addExtension(Symbol name, std::string_view requiresList, std::string_view depends, std::string_view promotedTo)
+{
+	if (name >= m_ids.size()) {
+		m_ids.resize(m_symbols->size() > name ? m_symbols->size() : name + 1, invalidId);
 	}
-	dependencyNames.insert(dependencies.begin(), dependencies.end());
+	m_ids[name] = m_names.size();
+	m_names.push_back(name);
+	m_promotedToCore.push_back(promotedTo.find("VK_VERSION_") == 0);
+
+	size_t position = 0;
+	while (position < requiresList.length())
+	{
+		size_t nameEnd = requiresList.find(',', position);
+		if (nameEnd == std::string_view::npos)
+			nameEnd = requiresList.length();
+		m_requiredNames.push_back(requiresList.substr(position, nameEnd - position));
+		position = nameEnd + 1;
+	}
+	if (!depends.empty()) {
+		size_t firstName = m_requiredNames.size();
+		position = 0;
+		if (parseDependsExpression(depends, position, m_requiredNames))
+			m_requiredNames.resize(firstName);
+	}
+	m_requiredNameOffsets.push_back(m_requiredNames.size());
 }
 
-void excludeDependentExtensions(const XMLElement* extensionsNode, const std::string& extensionName, std::unordered_set<std::string>& dependencyNames)
+void ExtensionGraph::reserve(size_t extensionCount)
 {
-	std::unordered_set<std::string> dependentExtensions;
-	const XMLElement* extensionNode = extensionsNode->FirstChildElement("extension");
-	while (extensionNode)
-	{
-		const char* name = extensionNode->Attribute("name");
-		if (name) {
-			const char* dependentExtensionsText = extensionNode->Attribute("requires");
-
-			if (dependentExtensionsText) {
-				std::vector<std::string> dependencyExtensions = splitList(dependentExtensionsText, ',');
-
-				for (auto& dependency : dependencyExtensions) {
-					if (dependency == extensionName) {
-						dependencyNames.erase(dependency);
-						dependentExtensions.insert(dependency);
-					}
-				}
-			}
+	m_names.reserve(extensionCount);
+	m_promotedToCore.reserve(extensionCount);
+	m_requiredNameOffsets.reserve(extensionCount + 1);
+}
+
+void ExtensionGraph::finalize()
+{
+	m_dependencyIds.reserve(m_requiredNames.size());
+	m_dependencyOffsets.reserve(m_names.size() + 1);
+	m_dependencyOffsets.push_back(0);
+	//Number of dependents per extension, turned into offsets below
+	std::vector<size_t> dependentCounts = std::vector<size_t>(m_names.size() + 1, 0);
+
+	for (size_t id = 0; id < m_names.size(); ++id) {
+		for (size_t i = m_requiredNameOffsets[id]; i < m_requiredNameOffsets[id + 1]; ++i) {
+			size_t requiredId = find(m_requiredNames[i]);
+			//Dependencies on unknown names (e.g. disabled or non-Vulkan APIs) can't be resolved and are ignored
+			if (requiredId == invalidId || requiredId == id) continue;
+
+			m_dependencyIds.push_back(requiredId);
+			if (!m_promotedToCore[requiredId])
+				++dependentCounts[requiredId + 1];
 		}
-		extensionNode = extensionNode->NextSiblingElement("extension");
+		m_dependencyOffsets.push_back(m_dependencyIds.size());
 	}
 
-	for (auto& dependency : dependentExtensions) {
-		excludeDependentExtensions(extensionsNode, dependency, dependentExtensions);
+	for (size_t id = 0; id < m_names.size(); ++id) {
+		dependentCounts[id + 1] += dependentCounts[id];
+	}
+	m_dependentOffsets = dependentCounts;
+	m_dependentIds.resize(m_dependentOffsets.back());
+	for (size_t id = 0; id < m_names.size(); ++id) {
+		for (size_t dependency : dependencies(id)) {
+			if (!m_promotedToCore[dependency])
+				m_dependentIds[dependentCounts[dependency]++] = id;
+		}
 	}
+
+	m_requiredNames = std::vector<std::string_view>();
+	m_requiredNameOffsets = std::vector<size_t>();
 }
 
-void listExtensionNames(const XMLElement* extensionsNode, std::unordered_set<std::string>& dependencyNames)
+size_t ExtensionGraph::find(std::string_view name) const
 {
-	const XMLElement* extensionNode = extensionsNode->FirstChildElement("extension");
-	while (extensionNode)
-	{
-		const char* name = extensionNode->Attribute("name");
-		if (name) {
-			dependencyNames.insert(name);
+	Symbol symbol = m_symbols->find(name);
+	return symbol < m_ids.size() ? m_ids[symbol] : invalidId;
+}
+
+ExtensionGraph buildExtensionGraph(const Registry& registry)
+{
+	ExtensionGraph graph = ExtensionGraph(registry.symbols);
+	graph.reserve(registry.extensions.size());
+	for (auto& extension : registry.extensions) {
+		graph.addExtension(extension.nameSymbol, extension.requiresList, extension.depends, extension.promotedTo);
+	}
+	graph.finalize();
+	return graph;
+}
+
+void includeExtensionDependencies(const ExtensionGraph& graph, std::string_view extensionName, std::vector<bool>& includedExtensions)
+{
+	size_t extensionId = graph.find(extensionName);
+	if (extensionId == ExtensionGraph::invalidId) {
+		std::cout << "Warning: Unknown extension " << extensionName << " in include list\n";
+		return;
+	}
+	if (includedExtensions[extensionId]) return;
+
+	//Breadth-first search over the dependencies, every extension is visited at most once
+	std::vector<size_t> queue = { extensionId };
+	includedExtensions[extensionId] = true;
+	for (size_t i = 0; i < queue.size(); ++i) {
+		for (size_t dependency : graph.dependencies(queue[i])) {
+			if (!includedExtensions[dependency]) {
+				includedExtensions[dependency] = true;
+				queue.push_back(dependency);
+			}
+		}
+	}
+}
+
+void excludeDependentExtensions(const ExtensionGraph& graph, std::string_view extensionName, std::vector<bool>& includedExtensions)
+{
+	size_t extensionId = graph.find(extensionName);
+	if (extensionId == ExtensionGraph::invalidId) {
+		std::cout << "Warning: Unknown extension " << extensionName << " in exclude list\n";
+		return;
+	}
+	if (!includedExtensions[extensionId]) return;
+
+	//Breadth-first search over the dependents, every extension is visited at most once
+	std::vector<size_t> queue = { extensionId };
+	includedExtensions[extensionId] = false;
+	for (size_t i = 0; i < queue.size(); ++i) {
+		for (size_t dependent : graph.dependents(queue[i])) {
+			if (includedExtensions[dependent]) {
+				includedExtensions[dependent] = false;
+				queue.push_back(dependent);
+			}
 		}
-		extensionNode = extensionNode->NextSiblingElement("extension");
 	}
 }
@@ -4,11 +4,14 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <ostream>
 #include <tinyxml2.h>
-#include <unordered_set>
+#include "registry.hpp"
+#include "parsing_utils.hpp"
+#include "generation_stats.hpp"
 
 //Main header generation logic.
 //Generates a C++ header based on the Vulkan vk.xml specification file.
@@ -37,12 +40,58 @@ struct ParsingOptions
 	bool valueRemovePostfix = false;
 	bool valueRemovePostfixOnCoreTypes = false;
 	std::vector<std::string> extensionTagNames;
+
+	//Write one header per feature/extension, an umbrella header and a forward declaration header instead of a single header
+	bool splitOutput = false;
+	//Additionally write the C++20 module interface VulkanEnums.cppm, exporting all enums
+	bool moduleOutput = false;
+	//Order enums by their generated name instead of by their position in vk.xml
+	bool sortEnums = false;
+	//Write constexpr std::string_view toString(E) for every enum, returning the value names as written to the header
+	bool generateToString = false;
+	//Write fromString<E>(std::string_view) for every enum, a perfect hash lookup of the value names as written to the header
+	bool generateFromString = false;
+	//Write forEachBit, setBits, bitIndex, popcount, any, all and none for bitmask enums, selected by the IsBitmaskEnum trait
+	bool generateBitHelpers = false;
+	//Write the operators of bitmask enums once as constexpr templates selected by IsBitmaskEnum instead of for every enum
+	bool operatorTemplates = false;
+	//Write EnumReflection<E> for every enum, with an array of all values, their count, minimum and maximum
+	bool generateReflection = false;
+	//Write toDenseIndex(E), fromDenseIndex<E>(size_t) and kDenseCount<E> for every enum, and the container EnumArray<E, T>
+	bool generateDenseIndex = false;
+	//Write isValid(E) for every enum that isn't a bitmask and kAllBits<E> and hasOnlyKnownBits(E) for every bitmask enum
+	bool generateValidation = false;
+	//Write EnumRuns<E> for every enum that isn't a bitmask, and validateMany and toDenseIndexMany checking whole arrays with SSE2 or AVX2
+	bool generateBulkOperations = false;
+	//Write std::hash<E> for every enum, the dense index if generateDenseIndex is set and the enum isn't a bitmask, otherwise the number
+	bool generateHash = false;
+	//Write EnumFlatMap<E, T> and kFlatMapCapacity<E> for every enum that isn't a bitmask
+	bool generateFlatMap = false;
+	//Write toVk, fromVk<E>, asVkArray and asVkSpan for every enum, and static_asserts comparing the enums with vulkan_core.h if it's available
+	bool generateVkInterop = false;
 };
 
+//Only the transformed names are owned, everything else points into the registry
 struct VulkanEnumValue
 {
-	std::string name, value, comment;
+	//Name as written to the header, set by transformNames
+	std::string name;
+	//Transformed name of the aliased value, empty if this value isn't an alias
+	std::string alias;
+	std::string_view originalName, originalAlias, comment;
+	//Untransformed value or bit position. Empty for extension values.
+	std::string_view value;
+	//Value computed from the extension number and offset, only valid if isExtensionValue is set
+	int64_t extensionValue = 0;
+	//Value as a number, including sign and bit position. Only valid if hasNumericValue is set, which it isn't for aliases.
+	//Unsigned 64-bit values above INT64_MAX are stored in two's complement.
+	int64_t numericValue = 0;
 	bool isBitpos = false;
+	bool isExtensionValue = false;
+	bool isNegative = false;
+	bool hasNumericValue = false;
+	//Feature or extension that added this value to an existing enum, null for values defined together with the enum
+	const RegistryBlock* addedBy = nullptr;
 };
 
 enum class VulkanEnumType {
@@ -52,91 +101,253 @@ enum class VulkanEnumType {
 class VulkanEnum
 {
 public:
+	//Name as written to the header, set by transformNames
 	std::string name;
-	std::string originalName;
+	std::string_view originalName;
 	bool isIncluded = false;
 	VulkanEnumType type = VulkanEnumType::Enum;
+	//Feature or extension whose <require> references this enum first. Valid for all included enums.
+	const RegistryBlock* group = nullptr;
 
 	//Enum value definitions are sometimes duplicated across vk.xml, this makes sure the same value name won't occur twice
-	void addEnumValue(std::string originalValueName, VulkanEnumValue value) {
-		if (m_originalValueNames.find(originalValueName) == m_originalValueNames.end()) {
-			m_values.push_back(value);
-			m_originalValueNames.insert(originalValueName);
+	void addEnumValue(Symbol originalValueName, VulkanEnumValue&& value) {
+		if (m_originalValueNames.insert(originalValueName)) {
+			m_values.push_back(std::move(value));
 		}
 	}
 
-	void addAliasEnumValue(std::string originalValueName, VulkanEnumValue value) {
-		if (m_originalValueNames.find(originalValueName) == m_originalValueNames.end()) {
-			m_aliasValues.push_back(value);
-			m_originalValueNames.insert(originalValueName);
+	void addAliasEnumValue(Symbol originalValueName, VulkanEnumValue&& value) {
+		if (m_originalValueNames.insert(originalValueName)) {
+			m_aliasValues.push_back(std::move(value));
 		}
 	}
 
 	const std::vector<VulkanEnumValue>& values() const {
 		return m_values;
 	}
+	std::vector<VulkanEnumValue>& values() {
+		return m_values;
+	}
 
 	const std::vector<VulkanEnumValue>& aliasValues() const {
 		return m_aliasValues;
 	}
+	std::vector<VulkanEnumValue>& aliasValues() {
+		return m_aliasValues;
+	}
 private:
 	std::vector<VulkanEnumValue> m_values;
 	//Alias values need to be put last in order to ensure the aliases are already defined
 	std::vector<VulkanEnumValue> m_aliasValues;
-	std::unordered_set<std::string> m_originalValueNames;
+	SymbolSet m_originalValueNames;
 };
 
-namespace std {
-	template<>
-	struct hash<VulkanEnum> {
-		size_t operator()(const VulkanEnum& enumValue) const {
-			return hash<string>()(enumValue.originalName);
+//All enums, keyed by the symbol of their original name.
+//Enums are stored contiguously in insertion (=registry) order, a table indexed by symbol maps to them.
+//Iteration follows that order, which makes the output independent of hashing and the standard library.
+class EnumMap
+{
+public:
+	explicit EnumMap(const SymbolTable& symbols) : m_symbols(&symbols) {}
+
+	//Returns the enum named by originalName, inserting an empty one if it doesn't exist
+	VulkanEnum& operator[](Symbol originalName) {
+		VulkanEnum* existingEnum = find(originalName);
+		if (existingEnum) return *existingEnum;
+		insert(originalName, VulkanEnum());
+		return m_enums.back();
+	}
+	//Returns false and leaves the map unchanged if an enum with the same name exists
+	bool insert(Symbol originalName, VulkanEnum&& vulkanEnum) {
+		if (originalName >= m_enumIndices.size()) {
+			m_enumIndices.resize(m_symbols->size() > originalName ? m_symbols->size() : originalName + 1, invalidIndex);
 		}
-	};
-}
+		if (m_enumIndices[originalName] != invalidIndex) return false;
+		m_enumIndices[originalName] = static_cast<uint32_t>(m_enums.size());
+		m_enums.push_back(std::move(vulkanEnum));
+		return true;
+	}
+
+	VulkanEnum* find(Symbol originalName) {
+		if (originalName >= m_enumIndices.size() || m_enumIndices[originalName] == invalidIndex) return nullptr;
+		return &m_enums[m_enumIndices[originalName]];
+	}
+	const VulkanEnum* find(Symbol originalName) const {
+		return const_cast<EnumMap*>(this)->find(originalName);
+	}
+	//Lookup by name, doesn't allocate
+	const VulkanEnum* find(std::string_view originalName) const {
+		Symbol symbol = m_symbols->find(originalName);
+		return symbol == invalidSymbol ? nullptr : find(symbol);
+	}
+
+	size_t size() const { return m_enums.size(); }
+	std::vector<VulkanEnum>::iterator begin() { return m_enums.begin(); }
+	std::vector<VulkanEnum>::iterator end() { return m_enums.end(); }
+	std::vector<VulkanEnum>::const_iterator begin() const { return m_enums.begin(); }
+	std::vector<VulkanEnum>::const_iterator end() const { return m_enums.end(); }
+private:
+	static constexpr uint32_t invalidIndex = ~static_cast<uint32_t>(0);
 
-using EnumMap = std::unordered_map<std::string, ::VulkanEnum>;
+	const SymbolTable* m_symbols;
+	std::vector<uint32_t> m_enumIndices;
+	std::vector<VulkanEnum> m_enums;
+};
+
+//One output file of the generator
+struct GeneratedFile
+{
+	//Relative to the output directory, '/'-separated
+	std::string path;
+	CodeWriter contents;
+};
 
 //Generates a full header file from document according to the parsing options and writes it to outStream.
 void generateFromDocument(const tinyxml2::XMLDocument& document, ParsingOptions& options, std::ostream& outStream);
+//Generates a full header file from an already loaded registry according to the parsing options and writes it to outStream.
+//jobCount is the number of threads used for formatting the enums, the output doesn't depend on it.
+void generateFromRegistry(const Registry& registry, ParsingOptions& options, std::ostream& outStream, unsigned int jobCount = 1);
+//Generates all output files from an already loaded registry. This is VulkanEnums.hpp, with options.splitOutput
+//additionally VulkanEnumsFwd.hpp and one header per feature/extension in VulkanEnums/, and with options.moduleOutput VulkanEnums.cppm.
+//If stats isn't null, the time of every phase and the number of generated enums and values are recorded in it.
+std::vector<GeneratedFile> generateFilesFromRegistry(const Registry& registry, ParsingOptions& options, unsigned int jobCount = 1, GenerationStats* stats = nullptr);
+
+//Combines hash with every option that influences the generated header.
+//Fields added to ParsingOptions need to be added here as well, or stale headers won't be regenerated.
+uint64_t hashParsingOptions(const ParsingOptions& options, uint64_t hash);
 
 //Document/Structure helpers
 
+//Fills registry from a tinyxml2 document. The registry references the document's strings.
+//Returns false if document has no registry root node.
+bool readRegistryDocument(const tinyxml2::XMLDocument& document, Registry& registry);
 //Look up all defined enums
-EnumMap parseBasicEnums(const tinyxml2::XMLElement* registry, const ParsingOptions& options);
+EnumMap parseBasicEnums(const Registry& registry);
 //Finds and includes all feature enums (=core enums that were added in later versions) and applies additions to existing enums.
-void includeFeatureEnums(const tinyxml2::XMLElement* registry, const ParsingOptions& options, EnumMap& enums);
+void includeFeatureEnums(const Registry& registry, EnumMap& enums);
 //Finds and includes all extension enums that are specified in the parsing options and applies additions to existing enums.
-void includeExtensionEnums(const tinyxml2::XMLElement* registry, const ParsingOptions& options, EnumMap& enums);
-//Writes the included enums to a stream
-void writeEnums(const EnumMap& enums, std::ostream& outStream, const ParsingOptions& options);
-//Writes one enum value to a stream
-void writeEnumValue(const VulkanEnumValue& enumValue, std::ostream& outStream, bool isLastValue);
+//Returns the number of included extensions.
+size_t includeExtensionEnums(const Registry& registry, const ParsingOptions& options, EnumMap& enums);
+//Sets the header names of all included enums and their values. Excluded enums are never written, so they keep empty names.
+void transformNames(EnumMap& enums, const ParsingOptions& options);
+//Writes the included enums to writer, formatting them on jobCount threads
+void writeEnums(const EnumMap& enums, CodeWriter& writer, const ParsingOptions& options, unsigned int jobCount = 1);
+//Writes the included enums to the split output files: VulkanEnums.hpp including a header per group (feature or extension)
+//and VulkanEnumsFwd.hpp declaring all enums. Groups are ordered like in the registry.
+std::vector<GeneratedFile> writeSplitEnums(const Registry& registry, const EnumMap& enums, const ParsingOptions& options, unsigned int jobCount = 1);
+//Writes the module interface unit of the module VulkanEnums, which exports the included enums and their operators
+void writeModule(const EnumMap& enums, CodeWriter& writer, const ParsingOptions& options, unsigned int jobCount = 1);
+//Writes one enum definition, its operators and the functions enabled in options to writer
+void writeEnum(const VulkanEnum& vulkanEnum, CodeWriter& writer, const ParsingOptions& options);
+//Writes the string table of vulkanEnum and constexpr toString(E), which looks names up in it
+void writeToString(const VulkanEnum& vulkanEnum, CodeWriter& writer);
+//Writes the perfect hash table of the value and alias names of vulkanEnum and the specialization of fromString<E>
+void writeFromString(const VulkanEnum& vulkanEnum, CodeWriter& writer);
+//Writes the specialization of EnumReflection<E> for vulkanEnum
+void writeReflection(const VulkanEnum& vulkanEnum, CodeWriter& writer);
+//Writes toDenseIndex, fromDenseIndex and kDenseCount of vulkanEnum, using run tables if its values aren't contiguous
+void writeDenseIndex(const VulkanEnum& vulkanEnum, CodeWriter& writer);
+//Writes isValid of a plain enum or kAllBits and hasOnlyKnownBits of a bitmask enum.
+//If hasRunFirsts, writeDenseIndex already wrote the run table, which isValid then reuses.
+void writeValidation(const VulkanEnum& vulkanEnum, CodeWriter& writer, bool hasRunFirsts);
+//Writes the specialization of EnumRuns<E> of a plain enum, the numeric run table validateMany and toDenseIndexMany work on
+void writeBulkOperations(const VulkanEnum& vulkanEnum, CodeWriter& writer);
+//Writes kFlatMapCapacity of a plain enum. If usesDenseIndex, EnumFlatMap places keys at their dense index instead of hashing them.
+void writeFlatMapCapacity(const VulkanEnum& vulkanEnum, CodeWriter& writer, bool usesDenseIndex);
+//Writes VulkanType<E> of vulkanEnum and the static_asserts comparing its layout and values with vulkan_core.h.
+//Everything is guarded by the macros vulkan_core.h defines for the feature or extension that added the enum or value.
+void writeVkInterop(const VulkanEnum& vulkanEnum, CodeWriter& writer);
+//Writes the std::hash specializations of enums, which have to be outside of the namespace of the enums
+void writeHashes(const std::vector<const VulkanEnum*>& enums, CodeWriter& writer, const ParsingOptions& options);
+//Writes one enum value to writer
+void writeEnumValue(const VulkanEnumValue& enumValue, CodeWriter& writer, bool isLastValue);
 
 //Node helpers
 
 //Parses a basic enum node which isn't an extension to other existing nodes
-VulkanEnum parseBasicEnumNode(const tinyxml2::XMLElement* node, const ParsingOptions& options);
-//Parses an extension node. Includes referenced enums and applies additions.
-void parseExtensionEnumNode(const tinyxml2::XMLElement* node, const ParsingOptions& options, EnumMap& enums);
+VulkanEnum parseBasicEnumNode(const RegistryEnum& node);
+//Parses a feature or extension node. Includes referenced enums and applies additions.
+void parseExtensionEnumNode(const RegistryBlock& node, EnumMap& enums);
 
 //Name/Value helpers
 
-//Parses an XML node containing an enum value
-void parseValueNode(const tinyxml2::XMLElement* node, VulkanEnum& vulkanEnum, const ParsingOptions& options);
+//Parses an enum value and adds it to vulkanEnum. block is the enclosing feature or extension, whose number is used for offset values,
+//or null for values of an <enums> node.
+void parseValueNode(const RegistryValue& node, const RegistryBlock* block, VulkanEnum& vulkanEnum);
+//Values of vulkanEnum that have a numeric value, sorted by it as the underlying type of the enum.
+//Of several values with the same number, only the first one is kept.
+std::vector<const VulkanEnumValue*> sortedNumericValues(const VulkanEnum& vulkanEnum);
+//Positions of the first values of the runs of consecutive numbers in sortedValues, followed by the number of values
+std::vector<size_t> valueRunStarts(const std::vector<const VulkanEnumValue*>& sortedValues);
 //Processes an enum name from its vk.xml form to the desired header form
 void processName(const ParsingOptions& options, std::string& name);
 //Processes an enum value name from its vk.xml form to the desired header form
-void processValueName(const ParsingOptions& options, std::string& valueName, const std::string& originalStructureName, bool allowLeadingDigits = false);
+void processValueName(const ParsingOptions& options, std::string& valueName, std::string_view originalStructureName, bool allowLeadingDigits = false);
 
 //Extension (dependency) helpers
 
-//For an <extension> node given by extensionNode, this function adds all extensions that are required by extensionNode to dependencyNames.
-//dependencyNames should be empty.
-void includeExtensionDependencies(const tinyxml2::XMLElement* extensionsNode, const std::string& extensionName, std::unordered_set<std::string>& dependencyNames);
-//This function removes all extensions that depend on the extension named by extensionName from dependencyNames.
-//The extensionsNode parameter does NOT specify the <extension> node, but its parent <extensions> node.
-void excludeDependentExtensions(const tinyxml2::XMLElement* extensionsNode, const std::string& extensionName, std::unordered_set<std::string>& dependencyNames);
-//This function lists all extensions.
-//The extensionsNode parameter does NOT specify the <extension> node, but its parent <extensions> node.
-void listExtensionNames(const tinyxml2::XMLElement* extensionsNode, std::unordered_set<std::string>& dependencyNames);
\ No newline at end of file
+//Dependency graph over all <extension> nodes. Built in one pass over the registry,
+//so include/exclude closures are a BFS over adjacency lists instead of rescanning <extensions>.
+//Names point into the registry, which must outlive the graph.
+class ExtensionGraph
+{
+public:
+	static constexpr size_t invalidId = ~static_cast<size_t>(0);
+
+	explicit ExtensionGraph(const SymbolTable& symbols) : m_symbols(&symbols) {}
+
+	//Contiguous list of extension ids
+	struct IdRange
+	{
+		const size_t* first;
+		const size_t* last;
+		const size_t* begin() const { return first; }
+		const size_t* end() const { return last; }
+	};
+
+	//Registers an extension, name must be interned in the symbol table. Ids are assigned in registration (=document) order.
+	//requiresList is the legacy ','-separated "requires" attribute, depends the boolean "depends" expression (+ = and, ',' = or).
+	//Any of the attributes may be empty.
+	void addExtension(Symbol name, std::string_view requiresList, std::string_view depends, std::string_view promotedTo);
+	//Preallocates storage for extensionCount extensions
+	void reserve(size_t extensionCount);
+	//Resolves all dependency names to ids and builds the reverse adjacency. Must be called after the last addExtension.
+	void finalize();
+
+	size_t find(std::string_view name) const;
+	size_t size() const { return m_names.size(); }
+	std::string_view name(size_t id) const { return m_symbols->string(m_names[id]); }
+	bool isPromotedToCore(size_t id) const { return m_promotedToCore[id]; }
+
+	//Extensions that the extension with the given id depends on
+	IdRange dependencies(size_t id) const {
+		return { m_dependencyIds.data() + m_dependencyOffsets[id], m_dependencyIds.data() + m_dependencyOffsets[id + 1] };
+	}
+	//Extensions that depend on the extension with the given id.
+	//Dependencies on extensions that were promoted to core are not listed, since core always satisfies them.
+	IdRange dependents(size_t id) const {
+		return { m_dependentIds.data() + m_dependentOffsets[id], m_dependentIds.data() + m_dependentOffsets[id + 1] };
+	}
+private:
+	const SymbolTable* m_symbols;
+	std::vector<Symbol> m_names;
+	//Extension id per symbol, invalidId for symbols that aren't extension names
+	std::vector<size_t> m_ids;
+	std::vector<bool> m_promotedToCore;
+	//Dependency names of all extensions, extension i owns [m_requiredNameOffsets[i], m_requiredNameOffsets[i + 1]).
+	//Only valid until finalize() resolved them.
+	std::vector<std::string_view> m_requiredNames;
+	std::vector<size_t> m_requiredNameOffsets = { 0 };
+	//Adjacency in compressed form, laid out like m_requiredNames
+	std::vector<size_t> m_dependencyIds, m_dependencyOffsets;
+	std::vector<size_t> m_dependentIds, m_dependentOffsets;
+};
+
+//Builds the dependency graph from all extensions of the registry. The graph references the registry.
+ExtensionGraph buildExtensionGraph(const Registry& registry);
+//Marks the extension named by extensionName and all extensions it (transitively) depends on in includedExtensions.
+//includedExtensions is indexed by extension id and must have graph.size() elements.
+void includeExtensionDependencies(const ExtensionGraph& graph, std::string_view extensionName, std::vector<bool>& includedExtensions);
+//Unmarks the extension named by extensionName and all extensions that (transitively) depend on it in includedExtensions.
+//includedExtensions is indexed by extension id and must have graph.size() elements.
+void excludeDependentExtensions(const ExtensionGraph& graph, std::string_view extensionName, std::vector<bool>& includedExtensions);
@@ -0,0 +1,151 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#include "generation_stats.hpp"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+
+namespace {
+
+std::atomic<uint32_t> nextThreadIndex = { 0 };
+
+double millisecondsBetween(StatsClock::time_point begin, StatsClock::time_point end) {
+	return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+int64_t microsecondsBetween(StatsClock::time_point begin, StatsClock::time_point end) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count();
+}
+
+void writeJsonString(std::ostream& stream, std::string_view string) {
+	stream << '"';
+	for (char character : string) {
+		switch (character) {
+		case '"': stream << "\\\""; break;
+		case '\\': stream << "\\\\"; break;
+		case '\n': stream << "\\n"; break;
+		case '\t': stream << "\\t"; break;
+		default:
+			if (static_cast<unsigned char>(character) < 0x20) {
+				stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character) << std::dec << std::setfill(' ');
+			}
+			else {
+				stream << character;
+			}
+		}
+	}
+	stream << '"';
+}
+
+//Phases with the same name are summed, in order of their first occurrence
+void writePhaseTimes(std::ostream& stream, const GenerationStats& stats) {
+	std::vector<std::pair<std::string_view, double>> times;
+	for (auto& phase : stats.phases) {
+		auto existingTime = times.begin();
+		while (existingTime != times.end() && existingTime->first != phase.name) ++existingTime;
+		if (existingTime == times.end()) {
+			times.emplace_back(phase.name, 0.0);
+			existingTime = times.end() - 1;
+		}
+		existingTime->second += millisecondsBetween(phase.begin, phase.end);
+	}
+
+	stream << "{";
+	for (size_t i = 0; i < times.size(); ++i) {
+		stream << (i ? ", " : " ");
+		writeJsonString(stream, times[i].first);
+		stream << ": " << times[i].second;
+	}
+	stream << (times.empty() ? "}" : " }");
+}
+
+void writeTraceEvents(std::ostream& stream, const GeneratorRunStats& runStats, const GenerationStats& stats, bool& isFirstEvent) {
+	for (auto& phase : stats.phases) {
+		stream << (isFirstEvent ? "\n" : ",\n") << "\t\t{ \"name\": ";
+		writeJsonString(stream, phase.name);
+		stream << ", \"cat\": \"generator\", \"ph\": \"X\", \"ts\": " << microsecondsBetween(runStats.start, phase.begin)
+			   << ", \"dur\": " << microsecondsBetween(phase.begin, phase.end) << ", \"pid\": 1, \"tid\": " << phase.thread;
+		if (!stats.name.empty()) {
+			stream << ", \"args\": { \"configuration\": ";
+			writeJsonString(stream, stats.name);
+			stream << " }";
+		}
+		stream << " }";
+		isFirstEvent = false;
+	}
+}
+
+}
+
+PhaseTimer::~PhaseTimer() {
+	if (m_stats) {
+		m_stats->phases.push_back({ m_name, m_begin, StatsClock::now(), currentThreadIndex() });
+	}
+}
+
+uint32_t currentThreadIndex() {
+	thread_local uint32_t threadIndex = nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+	return threadIndex;
+}
+
+bool writeStatsReport(const GeneratorRunStats& stats, const std::string& path) {
+	std::ofstream stream = std::ofstream(path, std::ios::binary | std::ios::trunc);
+	if (!stream.is_open()) return false;
+	stream << std::fixed << std::setprecision(3);
+
+	stream << "{\n";
+	stream << "\t\"version\": 1,\n";
+	stream << "\t\"jobs\": " << stats.jobCount << ",\n";
+	stream << "\t\"wallTimeMs\": " << millisecondsBetween(stats.start, StatsClock::now()) << ",\n";
+	stream << "\t\"phasesMs\": ";
+	writePhaseTimes(stream, stats.shared);
+	stream << ",\n";
+	stream << "\t\"allocations\": { \"count\": " << stats.allocationCount << ", \"bytes\": " << stats.allocatedBytes << " },\n";
+	stream << "\t\"peakRssBytes\": " << stats.peakResidentSetSize << ",\n";
+	stream << "\t\"configurations\": [";
+	for (size_t i = 0; i < stats.configurations.size(); ++i) {
+		const GenerationStats& configuration = stats.configurations[i];
+		const GenerationCounts& counts = configuration.counts;
+		stream << (i ? ",\n" : "\n") << "\t\t{\n";
+		stream << "\t\t\t\"name\": ";
+		writeJsonString(stream, configuration.name);
+		stream << ",\n";
+		stream << "\t\t\t\"upToDate\": " << (configuration.isUpToDate ? "true" : "false") << ",\n";
+		stream << "\t\t\t\"phasesMs\": ";
+		writePhaseTimes(stream, configuration);
+		stream << ",\n";
+		stream << "\t\t\t\"counts\": { \"enums\": " << counts.enums << ", \"includedEnums\": " << counts.includedEnums
+			   << ", \"values\": " << counts.values << ", \"aliases\": " << counts.aliases
+			   << ", \"includedExtensions\": " << counts.includedExtensions << ", \"excludedExtensions\": " << counts.excludedExtensions << " }\n";
+		stream << "\t\t}";
+	}
+	stream << (stats.configurations.empty() ? "]\n" : "\n\t]\n");
+	stream << "}\n";
+	return stream.good();
+}
+
+bool writeChromeTrace(const GeneratorRunStats& stats, const std::string& path) {
+	std::ofstream stream = std::ofstream(path, std::ios::binary | std::ios::trunc);
+	if (!stream.is_open()) return false;
+
+	stream << "{\n\t\"displayTimeUnit\": \"ms\",\n\t\"traceEvents\": [";
+	bool isFirstEvent = true;
+	writeTraceEvents(stream, stats, stats.shared, isFirstEvent);
+	uint32_t threadCount = 0;
+	for (auto& phase : stats.shared.phases) threadCount = std::max(threadCount, phase.thread + 1);
+	for (auto& configuration : stats.configurations) {
+		writeTraceEvents(stream, stats, configuration, isFirstEvent);
+		for (auto& phase : configuration.phases) threadCount = std::max(threadCount, phase.thread + 1);
+	}
+	//Thread 0 is the one that loaded the registry
+	for (uint32_t i = 0; i < threadCount; ++i) {
+		stream << (isFirstEvent ? "\n" : ",\n") << "\t\t{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << i
+			   << ", \"args\": { \"name\": \"" << (i ? "worker " : "main") << (i ? std::to_string(i) : std::string()) << "\" } }";
+		isFirstEvent = false;
+	}
+	stream << "\n\t]\n}\n";
+	return stream.good();
+}
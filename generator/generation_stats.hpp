@@ -0,0 +1,82 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#pragma once
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+//Wall times of the generator phases and counts of what was generated.
+//Written as a JSON report with --stats and as Chrome trace events with --trace.
+
+using StatsClock = std::chrono::steady_clock;
+
+//One timed phase on the thread that ran it
+struct PhaseRecord
+{
+	//Phase names are string literals
+	std::string_view name;
+	StatsClock::time_point begin;
+	StatsClock::time_point end;
+	uint32_t thread = 0;
+};
+
+//Sizes of the output of one configuration. Values and aliases are counted in included enums only.
+struct GenerationCounts
+{
+	size_t enums = 0;
+	size_t includedEnums = 0;
+	size_t values = 0;
+	size_t aliases = 0;
+	size_t includedExtensions = 0;
+	size_t excludedExtensions = 0;
+};
+
+//Statistics of one configuration, or of the phases shared by all configurations
+struct GenerationStats
+{
+	std::string name;
+	bool isUpToDate = false;
+	std::vector<PhaseRecord> phases;
+	GenerationCounts counts;
+};
+
+//Statistics of a whole generator run
+struct GeneratorRunStats
+{
+	StatsClock::time_point start = StatsClock::now();
+	unsigned int jobCount = 1;
+	//Loading vk.xml and writing the files, done once for all configurations
+	GenerationStats shared;
+	std::vector<GenerationStats> configurations;
+	uint64_t allocationCount = 0;
+	uint64_t allocatedBytes = 0;
+	uint64_t peakResidentSetSize = 0;
+};
+
+//Records the lifetime of the timer as a phase of stats. Does nothing if stats is null.
+class PhaseTimer
+{
+public:
+	PhaseTimer(GenerationStats* stats, std::string_view name) : m_stats(stats), m_name(name) {
+		if (m_stats) m_begin = StatsClock::now();
+	}
+	~PhaseTimer();
+
+	PhaseTimer(const PhaseTimer&) = delete;
+	PhaseTimer& operator=(const PhaseTimer&) = delete;
+private:
+	GenerationStats* m_stats;
+	std::string_view m_name;
+	StatsClock::time_point m_begin;
+};
+
+//Small index of the calling thread, assigned on first use. The first thread asking gets 0.
+uint32_t currentThreadIndex();
+
+//Writes the per-phase wall times in milliseconds (phases with the same name are summed), counts and memory usage as JSON
+bool writeStatsReport(const GeneratorRunStats& stats, const std::string& path);
+//Writes all phases as complete events ("ph": "X") of the Chrome trace event format, viewable in Perfetto or chrome://tracing
+bool writeChromeTrace(const GeneratorRunStats& stats, const std::string& path);
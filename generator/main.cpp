@@ -6,8 +6,16 @@
 #include <sstream>
 #include <algorithm>
 #include <fstream>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <cstdlib>
+#include <charconv>
+#include <unordered_set>
 #include "generate.hpp"
 #include "parsing_utils.hpp"
+#include "allocation_stats.hpp"
+#include "parallel.hpp"
 
 struct Argument
 {
@@ -44,8 +52,259 @@ std::vector<Argument> parseArguments(int argc, char** argv) {
 	return arguments;
 }
 
+//Applies argument to options if it is one of the options influencing the generated files.
+//Returns false if it isn't.
+bool applyArgument(const Argument& argument, ParsingOptions& options) {
+	if (argument.name == "namespace") {
+		options.useNamespaces = true;
+		options.namespaceName = argument.additionalData;
+	}
+	else if (argument.name == "exclude-extensions") {
+		options.excludeExtensions = true;
+	}
+	else if (argument.name == "include") {
+		options.includeExtensionList = splitList(argument.additionalData);
+	}
+	else if (argument.name == "exclude") {
+		options.excludeExtensionList = splitList(argument.additionalData);
+	}
+	else if (argument.name == "replace-names") {
+		options.replaceNames = true;
+	}
+	else if (argument.name == "name-prefix-replacement") {
+		options.namePrefixReplacement = argument.additionalData;
+	}
+	else if (argument.name == "name-remove-postfix") {
+		options.nameRemovePostfix = true;
+	}
+	else if (argument.name == "replace-values") {
+		options.replaceValues = true;
+	}
+	else if (argument.name == "value-prefix-replacement") {
+		options.valuePrefixReplacement = argument.additionalData;
+	}
+	else if (argument.name == "value-number-prefix") {
+		options.numberPrefix = argument.additionalData;
+	}
+	else if (argument.name == "remove-structure-names") {
+		options.removeStructureNames = true;
+	}
+	else if (argument.name == "remove-underscores") {
+		options.removeUnderscores = true;
+	}
+	else if (argument.name == "tolower") {
+		options.valueToLower = true;
+	}
+	else if (argument.name == "capitalize-start") {
+		options.valueCapitalizeStart = true;
+	}
+	else if (argument.name == "value-remove-postfix") {
+		options.valueRemovePostfix = true;
+	}
+	else if (argument.name == "value-remove-postfix-core-types") {
+		options.valueRemovePostfixOnCoreTypes = true;
+	}
+	else if (argument.name == "split-output") {
+		options.splitOutput = true;
+	}
+	else if (argument.name == "module") {
+		options.moduleOutput = true;
+	}
+	else if (argument.name == "sort-enums") {
+		options.sortEnums = true;
+	}
+	else if (argument.name == "to-string") {
+		options.generateToString = true;
+	}
+	else if (argument.name == "from-string") {
+		options.generateFromString = true;
+	}
+	else if (argument.name == "bit-helpers") {
+		options.generateBitHelpers = true;
+	}
+	else if (argument.name == "operator-templates") {
+		options.operatorTemplates = true;
+	}
+	else if (argument.name == "reflection") {
+		options.generateReflection = true;
+	}
+	else if (argument.name == "dense-index") {
+		options.generateDenseIndex = true;
+	}
+	else if (argument.name == "validation") {
+		options.generateValidation = true;
+	}
+	else if (argument.name == "bulk-operations") {
+		options.generateBulkOperations = true;
+	}
+	else if (argument.name == "hash") {
+		options.generateHash = true;
+	}
+	else if (argument.name == "flat-map") {
+		options.generateFlatMap = true;
+	}
+	else if (argument.name == "vk-interop") {
+		options.generateVkInterop = true;
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+//One set of options and the directory its files are written to
+struct OutputConfiguration
+{
+	std::string name;
+	std::filesystem::path outputDirectory;
+	ParsingOptions options;
+	uint64_t inputHash = 0;
+	bool isUpToDate = false;
+};
+
+std::string_view trim(std::string_view text) {
+	size_t first = text.find_first_not_of(" \t\r");
+	if (first == std::string_view::npos) return std::string_view();
+	size_t last = text.find_last_not_of(" \t\r");
+	return text.substr(first, last - first + 1);
+}
+
+//Reads a batch configuration file. Every "[name]" line starts a configuration based on baseOptions.
+//The following "argument" or "argument = value" lines are applied to it like command line arguments without the leading "--".
+//"output = directory" sets the directory the files are written to, which defaults to the name. Lines starting with '#' are ignored.
+bool readConfigurationFile(const std::string& path, const ParsingOptions& baseOptions, std::vector<OutputConfiguration>& configurations) {
+	std::ifstream file = std::ifstream(path);
+	if (!file.is_open()) {
+		std::cout << "Error: Error opening the configuration file " << path << "! Does the file exist?\n";
+		return false;
+	}
+
+	std::string line;
+	size_t lineNumber = 0;
+	while (std::getline(file, line)) {
+		++lineNumber;
+		std::string_view content = trim(line);
+		if (content.empty() || content[0] == '#') continue;
+
+		if (content.front() == '[' && content.back() == ']') {
+			OutputConfiguration& configuration = configurations.emplace_back();
+			configuration.name = trim(content.substr(1, content.size() - 2));
+			configuration.outputDirectory = std::filesystem::u8path(configuration.name);
+			configuration.options = baseOptions;
+			continue;
+		}
+		if (configurations.empty()) {
+			std::cout << "Error: " << path << ":" << lineNumber << ": Option outside of a [configuration] block\n";
+			return false;
+		}
+
+		Argument argument;
+		size_t separator = content.find('=');
+		argument.name = trim(content.substr(0, separator));
+		if (separator != std::string_view::npos) {
+			argument.additionalData = trim(content.substr(separator + 1));
+		}
+
+		if (argument.name == "output") {
+			configurations.back().outputDirectory = std::filesystem::u8path(argument.additionalData);
+		}
+		else if (!applyArgument(argument, configurations.back().options)) {
+			std::cout << "Warning: " << path << ":" << lineNumber << ": Unrecognized option " << argument.name << std::endl;
+		}
+	}
+	if (configurations.empty()) {
+		std::cout << "Error: The configuration file " << path << " contains no configurations\n";
+		return false;
+	}
+	return true;
+}
+
+//Hashes the contents of the file at path. Returns false if it can't be read.
+bool hashFile(const std::string& path, uint64_t& hash) {
+	MappedFile file;
+	if (!file.open(path)) return false;
+	hash = hashString(std::string_view(file.data(), file.size()));
+	return true;
+}
+
+constexpr std::string_view stampHeader = "VulkanEnumClasses stamp v2\n";
+
+//The stamp records the hash of the inputs the files of a configuration were generated from, followed by the path of every file, one per line
+std::string stampContents(uint64_t inputHash, const std::vector<std::string>& filePaths) {
+	std::ostringstream stream;
+	stream << stampHeader << std::hex << inputHash << "\n";
+	for (auto& filePath : filePaths) {
+		stream << filePath << "\n";
+	}
+	return stream.str();
+}
+
+//Reads the input hash and the file paths recorded in the stamp at path. Returns false if it doesn't exist or isn't a valid stamp.
+bool readStamp(const std::filesystem::path& path, uint64_t& inputHash, std::vector<std::string>& filePaths) {
+	MappedFile file;
+	if (!file.open(path.string())) return false;
+	std::string_view contents = std::string_view(file.data(), file.size());
+	if (contents.substr(0, stampHeader.size()) != stampHeader) return false;
+	contents.remove_prefix(stampHeader.size());
+
+	size_t lineEnd = contents.find('\n');
+	if (lineEnd == std::string_view::npos) return false;
+	std::from_chars_result result = std::from_chars(contents.data(), contents.data() + lineEnd, inputHash, 16);
+	if (result.ec != std::errc() || result.ptr != contents.data() + lineEnd) return false;
+	contents.remove_prefix(lineEnd + 1);
+
+	while (!contents.empty()) {
+		lineEnd = contents.find('\n');
+		//A missing line break means the stamp was cut off
+		if (lineEnd == std::string_view::npos || lineEnd == 0) return false;
+		filePaths.emplace_back(contents.substr(0, lineEnd));
+		contents.remove_prefix(lineEnd + 1);
+	}
+	return !filePaths.empty();
+}
+
+bool fileEquals(const std::filesystem::path& path, std::string_view contents) {
+	MappedFile file;
+	if (!file.open(path.string())) return contents.empty();
+	return std::string_view(file.data(), file.size()) == contents;
+}
+
+//Leaves the file (and its modification time) untouched if it already has the given contents
+bool writeFileIfChanged(const std::filesystem::path& path, std::string_view contents) {
+	if (fileEquals(path, contents)) return true;
+	std::ofstream file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) return false;
+	file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+	return file.good();
+}
+
+//Removes the headers in VulkanEnums/ that aren't one of filePaths, e.g. those of extensions an earlier configuration included
+void removeStaleGroupHeaders(const std::filesystem::path& outputDirectory, const std::vector<std::string>& filePaths) {
+	std::unordered_set<std::string> currentPaths = std::unordered_set<std::string>(filePaths.begin(), filePaths.end());
+	std::error_code error;
+	std::vector<std::filesystem::path> stalePaths;
+	for (auto& entry : std::filesystem::directory_iterator(outputDirectory / "VulkanEnums", error)) {
+		if (!entry.is_regular_file() || entry.path().extension() != ".hpp") continue;
+		std::string relativePath = "VulkanEnums/" + entry.path().filename().generic_string();
+		if (!currentPaths.count(relativePath)) stalePaths.push_back(entry.path());
+	}
+	for (auto& stalePath : stalePaths) {
+		if (!std::filesystem::remove(stalePath, error)) {
+			std::cout << "Warning: Unable to remove the stale header " << stalePath.string() << std::endl;
+		}
+	}
+}
+
 int main(int argc, char** argv) {
 	std::string xmlPath;
+	std::string configurationPath;
+	std::string snapshotPath;
+	bool useDocumentParser = false;
+	bool printAllocationStats = false;
+	std::string statsPath;
+	std::string tracePath;
+	unsigned int jobCount = 1;
+	bool forceGeneration = false;
 
 	ParsingOptions options;
 
@@ -55,71 +314,184 @@ int main(int argc, char** argv) {
 		else if (argument.name == "path") {
 			xmlPath = argument.additionalData;
 		}
-		else if (argument.name == "namespace") {
-			options.useNamespaces = true;
-			options.namespaceName = argument.additionalData;
-		}
-		else if (argument.name == "exclude-extensions") {
-			options.excludeExtensions = true;
+		else if (argument.name == "config") {
+			configurationPath = argument.additionalData;
 		}
-		else if (argument.name == "include") {
-			options.includeExtensionList = splitList(argument.additionalData);
+		else if (argument.name == "snapshot") {
+			snapshotPath = argument.additionalData;
 		}
-		else if (argument.name == "exclude") {
-			options.excludeExtensionList = splitList(argument.additionalData);
+		else if (argument.name == "dom") {
+			useDocumentParser = true;
 		}
-		else if (argument.name == "replace-names") {
-			options.replaceNames = true;
+		else if (argument.name == "allocation-stats") {
+			printAllocationStats = true;
 		}
-		else if (argument.name == "name-prefix-replacement") {
-			options.namePrefixReplacement = argument.additionalData;
+		else if (argument.name == "stats") {
+			statsPath = argument.additionalData;
 		}
-		else if (argument.name == "name-remove-postfix") {
-			options.nameRemovePostfix = true;
+		else if (argument.name == "trace") {
+			tracePath = argument.additionalData;
 		}
-		else if (argument.name == "replace-values") {
-			options.replaceValues = true;
+		else if (argument.name == "force") {
+			forceGeneration = true;
 		}
-		else if (argument.name == "value-prefix-replacement") {
-			options.valuePrefixReplacement = argument.additionalData;
+		else if (argument.name == "jobs") {
+			jobCount = static_cast<unsigned int>(std::atoi(argument.additionalData.c_str()));
+			if (jobCount == 0) {
+				jobCount = std::thread::hardware_concurrency();
+				if (jobCount == 0) jobCount = 1;
+			}
 		}
-		else if (argument.name == "value-number-prefix") {
-			options.numberPrefix = argument.additionalData;
-		}
-		else if (argument.name == "remove-structure-names") {
-			options.removeStructureNames = true;
+		else if (!applyArgument(argument, options)) {
+			std::cout << "Warning: Unrecognized argument " << argument.name << std::endl;
 		}
-		else if (argument.name == "remove-underscores") {
-			options.removeUnderscores = true;
+	}
+
+	//Without a configuration file, the command line options are the only configuration.
+	//Otherwise they are the defaults every configuration of the file starts with.
+	std::vector<OutputConfiguration> configurations;
+	if (configurationPath.empty()) {
+		configurations.emplace_back().options = options;
+	}
+	else if (!readConfigurationFile(configurationPath, options, configurations)) {
+		return EXIT_FAILURE;
+	}
+
+	//Timing only happens if a report is requested
+	GeneratorRunStats runStats;
+	bool collectStats = !statsPath.empty() || !tracePath.empty();
+	runStats.jobCount = jobCount;
+	runStats.configurations.resize(configurations.size());
+	for (size_t i = 0; i < configurations.size(); ++i) {
+		runStats.configurations[i].name = configurations[i].name;
+	}
+	GenerationStats* sharedStats = collectStats ? &runStats.shared : nullptr;
+	auto writeReports = [&]() {
+		AllocationStats allocationStats = currentAllocationStats();
+		runStats.allocationCount = allocationStats.allocationCount;
+		runStats.allocatedBytes = allocationStats.allocatedBytes;
+		runStats.peakResidentSetSize = peakResidentSetSize();
+		if (!statsPath.empty() && !writeStatsReport(runStats, statsPath)) {
+			std::cout << "Warning: Unable to write the statistics file " << statsPath << std::endl;
 		}
-		else if (argument.name == "tolower") {
-			options.valueToLower = true;
+		if (!tracePath.empty() && !writeChromeTrace(runStats, tracePath)) {
+			std::cout << "Warning: Unable to write the trace file " << tracePath << std::endl;
 		}
-		else if (argument.name == "capitalize-start") {
-			options.valueCapitalizeStart = true;
+	};
+
+	//The stamp of each configuration records the hash of the inputs its files were last generated from
+	//Everything depends on vk.xml and the generator itself, since a rebuilt generator may produce different output for the same inputs.
+	//If one of them can't be read, everything is always regenerated.
+	uint64_t xmlHash = 0;
+	uint64_t generatorHash = 0;
+	bool hasXmlHash = hashFile(xmlPath, xmlHash);
+	bool hasSourceHash = hasXmlHash && hashFile(argv[0], generatorHash);
+	uint64_t sourceHash = hashString(std::string_view(reinterpret_cast<const char*>(&generatorHash), sizeof(generatorHash)), xmlHash);
+	std::vector<size_t> pendingConfigurations;
+	for (size_t i = 0; i < configurations.size(); ++i) {
+		OutputConfiguration& configuration = configurations[i];
+		configuration.inputHash = hashParsingOptions(configuration.options, sourceHash);
+
+		std::filesystem::path outputPath = configuration.outputDirectory / "VulkanEnums.hpp";
+		std::filesystem::path stampPath = configuration.outputDirectory / "VulkanEnums.hpp.stamp";
+		uint64_t stampHash = 0;
+		std::vector<std::string> stampFiles;
+		if (hasSourceHash && !forceGeneration && readStamp(stampPath, stampHash, stampFiles) && stampHash == configuration.inputHash) {
+			//Every file written last time has to be there, e.g. a deleted split header is regenerated
+			bool hasAllFiles = std::all_of(stampFiles.begin(), stampFiles.end(), [&](const std::string& filePath) {
+				return MappedFile().open((configuration.outputDirectory / std::filesystem::u8path(filePath)).string());
+			});
+			if (hasAllFiles) {
+				//Still rewrite the stamp, build systems compare its modification time against vk.xml
+				std::ofstream(stampPath, std::ios::binary | std::ios::trunc) << stampContents(configuration.inputHash, stampFiles);
+				std::cout << outputPath.string() << " is up to date\n";
+				configuration.isUpToDate = true;
+				runStats.configurations[i].isUpToDate = true;
+			}
 		}
-		else if (argument.name == "value-remove-postfix") {
-			options.valueRemovePostfix = true;
+		if (!configuration.isUpToDate) {
+			pendingConfigurations.push_back(i);
 		}
-		else if (argument.name == "value-remove-postfix-core-types") {
-			options.valueRemovePostfixOnCoreTypes = true;
+	}
+	if (pendingConfigurations.empty()) {
+		writeReports();
+		return EXIT_SUCCESS;
+	}
+
+	//The snapshot only depends on vk.xml, so it stays valid when the options change.
+	//The streaming reader is the default, the tinyxml2 document is kept as a reference front end and never uses snapshots.
+	bool useSnapshot = !snapshotPath.empty() && hasXmlHash && !useDocumentParser;
+	tinyxml2::XMLDocument vkXml;
+	std::unique_ptr<Registry> registry = std::make_unique<Registry>();
+	bool hasLoadedSnapshot = false;
+	{
+		PhaseTimer loadTimer = PhaseTimer(sharedStats, "load");
+		hasLoadedSnapshot = useSnapshot && loadRegistrySnapshot(snapshotPath, xmlHash, *registry);
+		if (!hasLoadedSnapshot) {
+			registry = std::make_unique<Registry>();
+			if (useDocumentParser) {
+				vkXml.LoadFile(xmlPath.c_str());
+				if (vkXml.Error() || !readRegistryDocument(vkXml, *registry)) {
+					std::cout << "Error: Error opening or parsing" << xmlPath <<  "! Does the file exist?\n";
+					return EXIT_FAILURE;
+				}
+			}
+			else if (!loadRegistry(xmlPath, *registry)) {
+				std::cout << "Error: Error opening or parsing" << xmlPath <<  "! Does the file exist?\n";
+				return EXIT_FAILURE;
+			}
 		}
-		else {
-			std::cout << "Warning: Unrecognized argument " << argument.name << std::endl;
+	}
+	if (useSnapshot && !hasLoadedSnapshot) {
+		PhaseTimer snapshotTimer = PhaseTimer(sharedStats, "saveSnapshot");
+		if (!saveRegistrySnapshot(*registry, xmlHash, snapshotPath)) {
+			std::cout << "Warning: Unable to write the registry snapshot " << snapshotPath << std::endl;
 		}
 	}
 
-	tinyxml2::XMLDocument vkXml;
-	vkXml.LoadFile(xmlPath.c_str());
-	if (vkXml.Error()) {
-		std::cout << "Error: Error opening or parsing" << xmlPath <<  "! Does the file exist?\n";
-		return EXIT_FAILURE;
+	//Configurations only read the registry, so they are generated concurrently.
+	//A single configuration uses the threads for writing its enums instead.
+	std::vector<std::vector<GeneratedFile>> configurationFiles = std::vector<std::vector<GeneratedFile>>(pendingConfigurations.size());
+	unsigned int configurationJobCount = pendingConfigurations.size() == 1 ? jobCount : 1;
+	parallelFor(pendingConfigurations.size(), jobCount, [&](unsigned int, size_t i) {
+		size_t configurationIndex = pendingConfigurations[i];
+		GenerationStats* configurationStats = collectStats ? &runStats.configurations[configurationIndex] : nullptr;
+		configurationFiles[i] = generateFilesFromRegistry(*registry, configurations[configurationIndex].options, configurationJobCount, configurationStats);
+	});
+
+	{
+		PhaseTimer outputTimer = PhaseTimer(sharedStats, "output");
+		for (size_t i = 0; i < pendingConfigurations.size(); ++i) {
+			OutputConfiguration& configuration = configurations[pendingConfigurations[i]];
+			std::vector<std::string> filePaths;
+			for (auto& file : configurationFiles[i]) {
+				filePaths.push_back(file.path);
+				std::filesystem::path filePath = configuration.outputDirectory / std::filesystem::u8path(file.path);
+				std::error_code error;
+				if (filePath.has_parent_path()) {
+					std::filesystem::create_directories(filePath.parent_path(), error);
+				}
+				//Rewriting an identical header would make everything that includes it recompile
+				if (error || !writeFileIfChanged(filePath, file.contents.text())) {
+					std::cout << "Error: Error opening the output file " << filePath.string() << "! Is it in use?\n";
+					return EXIT_FAILURE;
+				}
+			}
+
+			if (configuration.options.splitOutput) {
+				removeStaleGroupHeaders(configuration.outputDirectory, filePaths);
+			}
+
+			std::ofstream stampFile = std::ofstream(configuration.outputDirectory / "VulkanEnums.hpp.stamp", std::ios::binary | std::ios::trunc);
+			if (hasSourceHash) {
+				stampFile << stampContents(configuration.inputHash, filePaths);
+			}
+		}
 	}
 
-	std::ofstream cppFile = std::ofstream("VulkanEnums.hpp", std::ios::trunc);
-	if (!cppFile.is_open()) {
-		std::cout << "Error: Error opening the output file! Is it in use?\n";
-		return EXIT_FAILURE;
+	if (printAllocationStats) {
+		AllocationStats stats = currentAllocationStats();
+		std::cout << "Allocations: " << stats.allocationCount << " (" << stats.allocatedBytes << " bytes), peak RSS: " << peakResidentSetSize() << " bytes\n";
 	}
-	generateFromDocument(vkXml, options, cppFile);
+	writeReports();
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#pragma once
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+//Minimal work-stealing parallel loop.
+//Every worker starts with a contiguous share of the items and takes them from the front.
+//A worker that runs out steals the back half of another worker's remaining range.
+//The calling thread participates as worker 0.
+
+namespace parallel_detail {
+
+	//Remaining range of one worker, packed as (begin << 32 | end) so owner and thieves can update it with one CAS
+	struct alignas(64) WorkRange
+	{
+		std::atomic<uint64_t> range = { 0 };
+	};
+
+	inline uint64_t packRange(uint32_t begin, uint32_t end) {
+		return (static_cast<uint64_t>(begin) << 32) | end;
+	}
+
+	//Takes the first item of range. Returns false if it is empty.
+	inline bool popFront(WorkRange& workRange, uint32_t& item) {
+		uint64_t range = workRange.range.load(std::memory_order_acquire);
+		while (true)
+		{
+			uint32_t begin = static_cast<uint32_t>(range >> 32);
+			uint32_t end = static_cast<uint32_t>(range);
+			if (begin >= end) return false;
+			if (workRange.range.compare_exchange_weak(range, packRange(begin + 1, end), std::memory_order_acq_rel)) {
+				item = begin;
+				return true;
+			}
+		}
+	}
+
+	//Removes the back half of victim's range and returns it in begin/end. Returns false if nothing could be stolen.
+	inline bool stealBack(WorkRange& victim, uint32_t& stolenBegin, uint32_t& stolenEnd) {
+		uint64_t range = victim.range.load(std::memory_order_acquire);
+		while (true)
+		{
+			uint32_t begin = static_cast<uint32_t>(range >> 32);
+			uint32_t end = static_cast<uint32_t>(range);
+			if (begin >= end) return false;
+			uint32_t split = end - (end - begin + 1) / 2;
+			if (victim.range.compare_exchange_weak(range, packRange(begin, split), std::memory_order_acq_rel)) {
+				stolenBegin = split;
+				stolenEnd = end;
+				return true;
+			}
+		}
+	}
+}
+
+//Calls task(workerIndex, itemIndex) exactly once for every item in [0, itemCount), using up to workerCount threads.
+//Items with the same workerIndex are never processed concurrently, so per-worker state can be indexed by it.
+template<typename Task>
+void parallelFor(size_t itemCount, unsigned int workerCount, Task&& task) {
+	if (workerCount > itemCount) workerCount = static_cast<unsigned int>(itemCount);
+	if (workerCount <= 1) {
+		for (size_t i = 0; i < itemCount; ++i) task(0u, i);
+		return;
+	}
+
+	std::vector<parallel_detail::WorkRange> ranges = std::vector<parallel_detail::WorkRange>(workerCount);
+	for (unsigned int i = 0; i < workerCount; ++i) {
+		uint32_t begin = static_cast<uint32_t>(itemCount * i / workerCount);
+		uint32_t end = static_cast<uint32_t>(itemCount * (i + 1) / workerCount);
+		ranges[i].range.store(parallel_detail::packRange(begin, end), std::memory_order_relaxed);
+	}
+
+	auto worker = [&](unsigned int workerIndex) {
+		parallel_detail::WorkRange& ownRange = ranges[workerIndex];
+		while (true)
+		{
+			uint32_t item;
+			while (parallel_detail::popFront(ownRange, item)) {
+				task(workerIndex, static_cast<size_t>(item));
+			}
+
+			bool hasStolen = false;
+			for (unsigned int offset = 1; offset < workerCount && !hasStolen; ++offset) {
+				uint32_t stolenBegin, stolenEnd;
+				if (parallel_detail::stealBack(ranges[(workerIndex + offset) % workerCount], stolenBegin, stolenEnd)) {
+					//Keep the first stolen item, the rest becomes stealable by others again
+					ownRange.range.store(parallel_detail::packRange(stolenBegin + 1, stolenEnd), std::memory_order_release);
+					task(workerIndex, static_cast<size_t>(stolenBegin));
+					hasStolen = true;
+				}
+			}
+			//Items are only ever moved between ranges by workers that then process them, so nothing is lost by stopping here
+			if (!hasStolen) return;
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(workerCount - 1);
+	for (unsigned int i = 1; i < workerCount; ++i) {
+		threads.emplace_back(worker, i);
+	}
+	worker(0);
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
@@ -4,11 +4,11 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <string_view>
 #include <ostream>
 #include <sstream>
-
-//defined in generate.cpp
-extern unsigned int indentationLevel;
+#include <charconv>
+#include <type_traits>
 
 inline std::vector<std::string> splitList(const std::string& list, char separator = ' ') {
 	std::stringstream listStream = std::stringstream(list);
@@ -22,51 +22,77 @@ inline std::vector<std::string> splitList(const std::string& list, char separato
 	return splitList;
 }
 
-inline void addLine(std::ostream& stream, const std::string& string) {
-	for (unsigned int i = 0; i < indentationLevel; ++i) {
-		stream << "	";
+//Accumulates generated code in one growable buffer and tracks the indentation level.
+//Lines are assembled from parts in place, without temporary strings.
+class CodeWriter
+{
+public:
+	CodeWriter() {
+		m_buffer.reserve(64 * 1024);
+	}
+
+	void indent() { ++m_indentationLevel; }
+	void outdent() { --m_indentationLevel; }
+	unsigned int indentationLevel() const { return m_indentationLevel; }
+	void setIndentationLevel(unsigned int indentationLevel) { m_indentationLevel = indentationLevel; }
+
+	//Appends one line at the current indentation level, consisting of all parts in order
+	template<typename... Parts>
+	void addLine(const Parts&... parts) {
+		m_buffer.append(m_indentationLevel, '\t');
+		(append(parts), ...);
+		m_buffer.push_back('\n');
 	}
-	stream << string << "\n";
-}
 
-inline void addEnumOperator(std::ostream& cppFile, const std::string& enumName, const std::string& operatorName, bool is64Bit) {
-	addLine(cppFile, "inline " + enumName + " operator" + operatorName + "(" + enumName + " one, " + enumName + " other) { ");
-	++indentationLevel;
-	if (is64Bit) {
-		addLine(cppFile, "return static_cast<" + enumName + ">(static_cast<uint64_t>(one) " + operatorName);
-		addLine(cppFile, "static_cast<uint64_t>(other));");
+	void append(std::string_view text) { m_buffer.append(text); }
+	void append(char character) { m_buffer.push_back(character); }
+	template<typename Integer, typename = std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, char>>>
+	void append(Integer value) {
+		char digits[24];
+		std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+		m_buffer.append(digits, result.ptr);
 	}
-	else {
-		addLine(cppFile, "return static_cast<" + enumName + ">(static_cast<uint32_t>(one) " + operatorName);
-		addLine(cppFile, "static_cast<uint32_t>(other));");
+
+	std::string_view text() const { return m_buffer; }
+	size_t size() const { return m_buffer.size(); }
+	//Writes all accumulated code with a single write call
+	void writeTo(std::ostream& stream) const {
+		stream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
 	}
-	--indentationLevel;
-	addLine(cppFile, "}");
+private:
+	std::string m_buffer;
+	unsigned int m_indentationLevel = 0;
+};
+
+inline void addEnumOperator(CodeWriter& writer, std::string_view enumName, std::string_view operatorName, bool is64Bit) {
+	std::string_view underlyingType = is64Bit ? "uint64_t" : "uint32_t";
+	writer.addLine("inline ", enumName, " operator", operatorName, "(", enumName, " one, ", enumName, " other) { ");
+	writer.indent();
+	writer.addLine("return static_cast<", enumName, ">(static_cast<", underlyingType, ">(one) ", operatorName);
+	writer.addLine("static_cast<", underlyingType, ">(other));");
+	writer.outdent();
+	writer.addLine("}");
 }
 
-inline void removeTags(const std::vector<std::string> extensionTags, std::string& taggedString, bool removeUnderscore = false) {
+inline void removeTags(const std::vector<std::string>& extensionTags, std::string& taggedString, bool removeUnderscore = false) {
 	for (auto& tag : extensionTags) {
-		std::string searchValue = tag;
-		if (removeUnderscore) {
-			searchValue = "_" + searchValue;
-		}
-		if (taggedString.length() < searchValue.length()) continue;
+		size_t searchLength = tag.length() + (removeUnderscore ? 1 : 0);
+		if (taggedString.length() < searchLength) continue;
 		//Verify the structure name ends with the tag, and replace it
-		size_t expectedTagOffset = taggedString.length() - searchValue.length();
-		if (taggedString.find(searchValue, expectedTagOffset) == expectedTagOffset) {
+		size_t expectedTagOffset = taggedString.length() - searchLength;
+		if (removeUnderscore && taggedString[expectedTagOffset] != '_') continue;
+		if (taggedString.compare(taggedString.length() - tag.length(), tag.length(), tag) == 0) {
 			taggedString.erase(taggedString.begin() + expectedTagOffset, taggedString.end());
 			break;
 		}
 	}
 }
 
-inline bool hasTags(const std::vector<std::string> extensionTags, const std::string& taggedString) {
+inline bool hasTags(const std::vector<std::string>& extensionTags, std::string_view taggedString) {
 	for (auto& tag : extensionTags) {
-		std::string searchValue = tag;
-		if (taggedString.length() < searchValue.length()) continue;
-		//Verify the structure name ends with the tag, and replace it
-		size_t expectedTagOffset = taggedString.length() - searchValue.length();
-		if (taggedString.find(searchValue, expectedTagOffset) == expectedTagOffset) {
+		if (taggedString.length() < tag.length()) continue;
+		//Verify the structure name ends with the tag
+		if (taggedString.compare(taggedString.length() - tag.length(), tag.length(), tag) == 0) {
 			return true;
 		}
 	}
@@ -77,8 +103,9 @@ inline bool isSpecConsideredUpper(char character) {
 	return isupper(character) || isdigit(character);
 }
 
-inline std::string structureNameToEnumValue(const std::string& name) {
-	std::string newName;
+//Writes the value form of a structure name (e.g. VkImageLayout becomes VK_IMAGE_LAYOUT) to newName
+inline void structureNameToEnumValue(std::string_view name, std::string& newName) {
+	newName.clear();
 	for (size_t i = 0; i < name.length(); ++i) {
 		//Do not check the first character for being uppercase,
 		//otherwise one underscore is always prepended.
@@ -96,5 +123,4 @@ inline std::string structureNameToEnumValue(const std::string& name) {
 	if (flagBitOffset != std::string::npos) {
 		newName.replace(flagBitOffset, 10, "");
 	}
-	return newName;
-}
\ No newline at end of file
+}
@@ -0,0 +1,461 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#include "registry.hpp"
+#include <cstring>
+#include <cstdlib>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+//Minimal pull parser for the XML subset used by vk.xml.
+//Attribute values are returned as views into the source buffer, only values containing entities are copied.
+class RegistryReader
+{
+public:
+	enum class Token {
+		StartElement, EndElement, End, Error
+	};
+
+	RegistryReader(const char* begin, const char* end, std::deque<std::string>& decodedStrings)
+		: m_position(begin), m_end(end), m_decodedStrings(decodedStrings) {}
+
+	//Advances to the next start or end tag. Text, comments, processing instructions and CDATA are skipped.
+	//Self-closing elements produce a start and an end tag.
+	Token next();
+	std::string_view elementName() const { return m_elementName; }
+	//Value of an attribute of the current start element, empty if it isn't present
+	std::string_view attribute(std::string_view name) const;
+	//Skips the content of the current start element up to and including its end tag.
+	//Nested elements are only scanned for their boundaries, their attributes aren't parsed.
+	bool skipElement();
+private:
+	const char* m_position;
+	const char* m_end;
+	std::deque<std::string>& m_decodedStrings;
+
+	std::string_view m_elementName;
+	std::vector<std::pair<std::string_view, std::string_view>> m_attributes;
+	bool m_hasPendingEndElement = false;
+
+	//Skips a comment, CDATA section, processing instruction or declaration at the current position.
+	bool skipSpecialNode();
+	//Finds the closing '>' of a tag, ignoring '>' inside attribute values
+	const char* findTagEnd(const char* position) const;
+	bool parseStartTag();
+	std::string_view decodeEntities(std::string_view value);
+
+	bool startsWith(const char* position, const char* prefix) const {
+		size_t length = strlen(prefix);
+		return static_cast<size_t>(m_end - position) >= length && !memcmp(position, prefix, length);
+	}
+};
+
+bool isNameEnd(char character) {
+	return character == ' ' || character == '\t' || character == '\r' || character == '\n' || character == '/' || character == '>' || character == '=';
+}
+
+bool isWhitespace(char character) {
+	return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+}
+
+RegistryReader::Token RegistryReader::next()
+{
+	if (m_hasPendingEndElement) {
+		m_hasPendingEndElement = false;
+		return Token::EndElement;
+	}
+
+	while (true)
+	{
+		m_position = static_cast<const char*>(memchr(m_position, '<', m_end - m_position));
+		if (!m_position) {
+			m_position = m_end;
+			return Token::End;
+		}
+
+		if (startsWith(m_position, "<!") || startsWith(m_position, "<?")) {
+			if (!skipSpecialNode()) return Token::Error;
+			continue;
+		}
+
+		if (startsWith(m_position, "</")) {
+			const char* nameBegin = m_position + 2;
+			const char* nameEnd = nameBegin;
+			while (nameEnd < m_end && !isNameEnd(*nameEnd)) ++nameEnd;
+			const char* tagEnd = static_cast<const char*>(memchr(nameEnd, '>', m_end - nameEnd));
+			if (!tagEnd) return Token::Error;
+
+			m_elementName = std::string_view(nameBegin, nameEnd - nameBegin);
+			m_position = tagEnd + 1;
+			return Token::EndElement;
+		}
+
+		return parseStartTag() ? Token::StartElement : Token::Error;
+	}
+}
+
+std::string_view RegistryReader::attribute(std::string_view name) const
+{
+	for (auto& attribute : m_attributes) {
+		if (attribute.first == name) return attribute.second;
+	}
+	return std::string_view();
+}
+
+bool RegistryReader::skipElement()
+{
+	if (m_hasPendingEndElement) {
+		m_hasPendingEndElement = false;
+		return true;
+	}
+
+	size_t depth = 1;
+	while (depth)
+	{
+		m_position = static_cast<const char*>(memchr(m_position, '<', m_end - m_position));
+		if (!m_position) return false;
+
+		if (startsWith(m_position, "<!") || startsWith(m_position, "<?")) {
+			if (!skipSpecialNode()) return false;
+			continue;
+		}
+
+		const char* tagEnd = findTagEnd(m_position);
+		if (!tagEnd) return false;
+
+		if (m_position[1] == '/') {
+			--depth;
+		}
+		else if (tagEnd[-1] != '/') {
+			++depth;
+		}
+		m_position = tagEnd + 1;
+	}
+	return true;
+}
+
+bool RegistryReader::skipSpecialNode()
+{
+	const char* terminator;
+	if (startsWith(m_position, "<!--")) {
+		terminator = "-->";
+	}
+	else if (startsWith(m_position, "<![CDATA[")) {
+		terminator = "]]>";
+	}
+	else if (startsWith(m_position, "<?")) {
+		terminator = "?>";
+	}
+	else {
+		terminator = ">";
+	}
+
+	size_t terminatorLength = strlen(terminator);
+	for (const char* position = m_position + 2; position < m_end; ++position) {
+		if (startsWith(position, terminator)) {
+			m_position = position + terminatorLength;
+			return true;
+		}
+	}
+	return false;
+}
+
+const char* RegistryReader::findTagEnd(const char* position) const
+{
+	char quote = 0;
+	for (; position < m_end; ++position) {
+		if (quote) {
+			if (*position == quote) quote = 0;
+		}
+		else if (*position == '"' || *position == '\'') {
+			quote = *position;
+		}
+		else if (*position == '>') {
+			return position;
+		}
+	}
+	return nullptr;
+}
+
+bool RegistryReader::parseStartTag()
+{
+	const char* position = m_position + 1;
+	const char* nameBegin = position;
+	while (position < m_end && !isNameEnd(*position)) ++position;
+	m_elementName = std::string_view(nameBegin, position - nameBegin);
+	m_attributes.clear();
+
+	while (true)
+	{
+		while (position < m_end && isWhitespace(*position)) ++position;
+		if (position >= m_end) return false;
+
+		if (*position == '>') {
+			m_position = position + 1;
+			return true;
+		}
+		if (*position == '/') {
+			if (position + 1 >= m_end || position[1] != '>') return false;
+			m_position = position + 2;
+			m_hasPendingEndElement = true;
+			return true;
+		}
+
+		const char* attributeNameBegin = position;
+		while (position < m_end && !isNameEnd(*position)) ++position;
+		std::string_view attributeName = std::string_view(attributeNameBegin, position - attributeNameBegin);
+
+		while (position < m_end && isWhitespace(*position)) ++position;
+		if (position >= m_end || *position != '=') return false;
+		++position;
+		while (position < m_end && isWhitespace(*position)) ++position;
+		if (position >= m_end || (*position != '"' && *position != '\'')) return false;
+
+		char quote = *position++;
+		const char* valueBegin = position;
+		const char* valueEnd = static_cast<const char*>(memchr(valueBegin, quote, m_end - valueBegin));
+		if (!valueEnd) return false;
+		position = valueEnd + 1;
+
+		std::string_view value = std::string_view(valueBegin, valueEnd - valueBegin);
+		if (value.find('&') != std::string_view::npos) {
+			value = decodeEntities(value);
+		}
+		m_attributes.emplace_back(attributeName, value);
+	}
+}
+
+std::string_view RegistryReader::decodeEntities(std::string_view value)
+{
+	std::string decoded;
+	decoded.reserve(value.length());
+	for (size_t i = 0; i < value.length(); ++i) {
+		size_t entityEnd = value[i] == '&' ? value.find(';', i) : std::string_view::npos;
+		if (entityEnd == std::string_view::npos) {
+			decoded.push_back(value[i]);
+			continue;
+		}
+
+		std::string_view entity = value.substr(i + 1, entityEnd - i - 1);
+		if (entity == "lt") decoded.push_back('<');
+		else if (entity == "gt") decoded.push_back('>');
+		else if (entity == "amp") decoded.push_back('&');
+		else if (entity == "quot") decoded.push_back('"');
+		else if (entity == "apos") decoded.push_back('\'');
+		else if (entity.length() > 1 && entity[0] == '#') {
+			bool isHex = entity[1] == 'x';
+			unsigned long codepoint = strtoul(std::string(entity.substr(isHex ? 2 : 1)).c_str(), nullptr, isHex ? 16 : 10);
+			//Encode as UTF-8
+			if (codepoint < 0x80) {
+				decoded.push_back(static_cast<char>(codepoint));
+			}
+			else if (codepoint < 0x800) {
+				decoded.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+				decoded.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+			}
+			else if (codepoint < 0x10000) {
+				decoded.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+				decoded.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+				decoded.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+			}
+			else {
+				decoded.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+				decoded.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+				decoded.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+				decoded.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+			}
+		}
+		else {
+			//Unknown entity, keep it as-is
+			decoded.append(value.substr(i, entityEnd - i + 1));
+		}
+		i = entityEnd;
+	}
+	m_decodedStrings.push_back(std::move(decoded));
+	return m_decodedStrings.back();
+}
+
+RegistryValue readValue(const RegistryReader& reader, SymbolTable& symbols)
+{
+	RegistryValue value;
+	value.name = reader.attribute("name");
+	value.value = reader.attribute("value");
+	value.bitpos = reader.attribute("bitpos");
+	value.alias = reader.attribute("alias");
+	value.offset = reader.attribute("offset");
+	value.comment = reader.attribute("comment");
+	value.dir = reader.attribute("dir");
+	value.extends = reader.attribute("extends");
+	value.extnumber = reader.attribute("extnumber");
+	value.nameSymbol = symbols.intern(value.name);
+	if (!value.extends.empty()) value.extendsSymbol = symbols.intern(value.extends);
+	return value;
+}
+
+//Reads the children of the current element. Calls childCallback for every direct child start element,
+//which is responsible for consuming the child including its end tag.
+template<typename Callback>
+bool readChildren(RegistryReader& reader, Callback childCallback)
+{
+	while (true)
+	{
+		switch (reader.next()) {
+		case RegistryReader::Token::StartElement:
+			if (!childCallback()) return false;
+			break;
+		case RegistryReader::Token::EndElement:
+			return true;
+		default:
+			return false;
+		}
+	}
+}
+
+bool readBlock(RegistryReader& reader, RegistryBlock& block, SymbolTable& symbols)
+{
+	block.name = reader.attribute("name");
+	block.nameSymbol = symbols.intern(block.name);
+	block.number = reader.attribute("number");
+	block.requiresList = reader.attribute("requires");
+	block.depends = reader.attribute("depends");
+	block.promotedTo = reader.attribute("promotedto");
+
+	return readChildren(reader, [&]() {
+		if (reader.elementName() != "require") return reader.skipElement();
+
+		return readChildren(reader, [&]() {
+			if (reader.elementName() == "enum") {
+				if (!reader.attribute("extends").empty()) {
+					block.values.push_back(readValue(reader, symbols));
+				}
+			}
+			else if (reader.elementName() == "type") {
+				std::string_view name = reader.attribute("name");
+				if (!name.empty()) block.types.push_back(symbols.intern(name));
+			}
+			return reader.skipElement();
+		});
+	});
+}
+
+bool readRegistryChild(RegistryReader& reader, Registry& registry)
+{
+	std::string_view elementName = reader.elementName();
+
+	if (elementName == "tags") {
+		return readChildren(reader, [&]() {
+			if (reader.elementName() == "tag") {
+				std::string_view name = reader.attribute("name");
+				if (!name.empty()) registry.tags.push_back(name);
+			}
+			return reader.skipElement();
+		});
+	}
+	else if (elementName == "enums") {
+		if (reader.attribute("name") == "API Constants") return reader.skipElement();
+
+		RegistryEnum registryEnum;
+		registryEnum.name = reader.attribute("name");
+		registryEnum.type = reader.attribute("type");
+		registryEnum.bitwidth = reader.attribute("bitwidth");
+		registryEnum.nameSymbol = registry.symbols.intern(registryEnum.name);
+		bool success = readChildren(reader, [&]() {
+			if (reader.elementName() == "enum") {
+				registryEnum.values.push_back(readValue(reader, registry.symbols));
+			}
+			return reader.skipElement();
+		});
+		registry.enums.push_back(std::move(registryEnum));
+		return success;
+	}
+	else if (elementName == "feature") {
+		registry.features.emplace_back();
+		return readBlock(reader, registry.features.back(), registry.symbols);
+	}
+	else if (elementName == "extensions") {
+		return readChildren(reader, [&]() {
+			if (reader.elementName() == "extension" && !reader.attribute("name").empty()) {
+				registry.extensions.emplace_back();
+				return readBlock(reader, registry.extensions.back(), registry.symbols);
+			}
+			return reader.skipElement();
+		});
+	}
+	//<types>, <commands> and everything else is irrelevant
+	return reader.skipElement();
+}
+
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+	if (m_data) UnmapViewOfFile(m_data);
+	if (m_mappingHandle) CloseHandle(m_mappingHandle);
+	if (m_fileHandle && m_fileHandle != INVALID_HANDLE_VALUE) CloseHandle(m_fileHandle);
+#else
+	if (m_data) munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
+
+bool MappedFile::open(const std::string& path)
+{
+#ifdef _WIN32
+	m_fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_fileHandle == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_fileHandle, &fileSize) || !fileSize.QuadPart) return false;
+
+	m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_mappingHandle) return false;
+
+	m_data = static_cast<const char*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (!m_data) return false;
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) return false;
+
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) || !fileStatus.st_size) {
+		close(fileDescriptor);
+		return false;
+	}
+
+	void* mapping = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	//The mapping stays valid after closing the descriptor
+	close(fileDescriptor);
+	if (mapping == MAP_FAILED) return false;
+
+	m_data = static_cast<const char*>(mapping);
+	m_size = static_cast<size_t>(fileStatus.st_size);
+	//The registry is read front to back exactly once
+	madvise(mapping, m_size, MADV_SEQUENTIAL);
+#endif
+	return true;
+}
+
+bool loadRegistry(const std::string& path, Registry& registry)
+{
+	if (!registry.source.open(path)) {
+		return false;
+	}
+
+	RegistryReader reader = RegistryReader(registry.source.data(), registry.source.data() + registry.source.size(), registry.decodedStrings);
+	if (reader.next() != RegistryReader::Token::StartElement || reader.elementName() != "registry") {
+		return false;
+	}
+	return readChildren(reader, [&]() { return readRegistryChild(reader, registry); });
+}
@@ -0,0 +1,100 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <string_view>
+#include "symbol_table.hpp"
+
+//Raw, untransformed view of the parts of vk.xml that are relevant for enum generation.
+//All strings point into memory owned by whoever filled the registry (the streaming reader's
+//buffer or a tinyxml2 document), so the registry must not outlive it.
+
+//Attributes of one <enum> value node. Attributes that aren't present are empty.
+struct RegistryValue
+{
+	std::string_view name, value, bitpos, alias, offset, comment, dir, extends, extnumber;
+	Symbol nameSymbol = invalidSymbol;
+	Symbol extendsSymbol = invalidSymbol;
+};
+
+//An <enums> node defining a basic enum
+struct RegistryEnum
+{
+	std::string_view name, type, bitwidth;
+	Symbol nameSymbol = invalidSymbol;
+	std::vector<RegistryValue> values;
+};
+
+//A <feature> or <extension> node. Only the contents of its <require> children are kept.
+struct RegistryBlock
+{
+	std::string_view name, number;
+	Symbol nameSymbol = invalidSymbol;
+	//Dependency attributes, only used by extensions
+	std::string_view requiresList, depends, promotedTo;
+	//<enum> nodes extending other enums
+	std::vector<RegistryValue> values;
+	//Names of all <type> nodes
+	std::vector<Symbol> types;
+};
+
+//Read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	//Maps the file at path. Returns false if it can't be opened or is empty.
+	bool open(const std::string& path);
+
+	const char* data() const { return m_data; }
+	size_t size() const { return m_size; }
+private:
+	const char* m_data = nullptr;
+	size_t m_size = 0;
+#ifdef _WIN32
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+#endif
+};
+
+struct Registry
+{
+	std::vector<std::string_view> tags;
+	std::vector<RegistryEnum> enums;
+	std::vector<RegistryBlock> features;
+	std::vector<RegistryBlock> extensions;
+	//Names of enums, values, types and extensions
+	SymbolTable symbols;
+
+	//Storage for the streaming reader. The registry is filled in place and never copied,
+	//so views into these stay valid.
+	MappedFile source;
+	//Attribute values containing entities can't point into source and are decoded into here
+	std::deque<std::string> decodedStrings;
+
+	Registry() = default;
+	Registry(const Registry&) = delete;
+	Registry& operator=(const Registry&) = delete;
+};
+
+//Reads vk.xml in a single forward pass without building a DOM, skipping all subtrees
+//(<types>, <commands>, ...) that don't contribute to enums.
+//The file is memory-mapped and all strings in the registry point into the mapping.
+//Returns false if the file can't be opened or isn't a well-formed registry.
+bool loadRegistry(const std::string& path, Registry& registry);
+
+//Writes a binary snapshot of registry to path, tagged with sourceHash (the hash of the vk.xml it was read from).
+//The snapshot contains the registry exactly as read, before any name processing.
+bool saveRegistrySnapshot(const Registry& registry, uint64_t sourceHash, const std::string& path);
+//Loads a snapshot written by saveRegistrySnapshot into an empty registry. The snapshot is memory-mapped and all strings point into it.
+//Returns false if the file doesn't exist, was written from a different vk.xml (sourceHash) or by a different format version, or is corrupt.
+//The registry is in an unspecified state after a failed load and must not be reused.
+bool loadRegistrySnapshot(const std::string& path, uint64_t sourceHash, Registry& registry);
@@ -0,0 +1,340 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#include "registry.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <unordered_map>
+#include <filesystem>
+
+//Snapshot layout, all integers in host byte order:
+//SnapshotHeader, then the sections symbols, tags (SnapshotString), enums (SnapshotEnum), features, extensions (SnapshotBlock),
+//values (SnapshotValue), types (Symbol) and the string pool. Every section starts at a multiple of 8 bytes.
+//Strings are (offset, length) pairs into the pool, which the loaded registry points into directly.
+
+namespace {
+
+constexpr char snapshotMagic[8] = { 'V', 'K', 'E', 'N', 'U', 'M', 'R', 'G' };
+//Bump whenever the layout below, the Registry structures or the registry reader change
+constexpr uint32_t snapshotFormatVersion = 3;
+
+struct SnapshotString
+{
+	uint32_t offset, length;
+};
+
+struct SnapshotValue
+{
+	SnapshotString name, value, bitpos, alias, offset, comment, dir, extends, extnumber;
+	Symbol nameSymbol, extendsSymbol;
+};
+
+struct SnapshotEnum
+{
+	SnapshotString name, type, bitwidth;
+	Symbol nameSymbol;
+	uint32_t firstValue, valueCount;
+};
+
+struct SnapshotBlock
+{
+	SnapshotString name, number, requiresList, depends, promotedTo;
+	Symbol nameSymbol;
+	uint32_t firstValue, valueCount, firstType, typeCount;
+};
+
+struct SnapshotHeader
+{
+	char magic[8];
+	uint32_t formatVersion;
+	//Catches snapshots written by a build with different structure padding
+	uint32_t headerSize;
+	uint64_t sourceHash;
+	//Hash of the whole file with this field set to 0, catches snapshots damaged after they were written
+	uint64_t checksum;
+	uint32_t symbolCount, tagCount, enumCount, featureCount, extensionCount, valueCount, typeCount;
+	uint32_t stringPoolSize;
+};
+
+constexpr size_t alignSection(size_t offset) {
+	return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+//Hashes 8 bytes per step, hashString's byte loop would double the time it takes to load large snapshots.
+//Every step is a bijection of the hash, so any change of a single word changes the result.
+uint64_t hashBytes(const char* data, size_t size, uint64_t hash) {
+	size_t index = 0;
+	for (; index + sizeof(uint64_t) <= size; index += sizeof(uint64_t)) {
+		uint64_t word;
+		std::memcpy(&word, data + index, sizeof(uint64_t));
+		hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+		hash ^= hash >> 32;
+	}
+	for (; index < size; ++index) {
+		hash = (hash ^ static_cast<uint8_t>(data[index])) * 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+//Hash of a snapshot whose header is header, data and size cover the whole file
+uint64_t snapshotChecksum(SnapshotHeader header, const char* data, size_t size) {
+	header.checksum = 0;
+	uint64_t hash = hashBytes(reinterpret_cast<const char*>(&header), sizeof(header), 0xCBF29CE484222325ULL);
+	size_t payloadOffset = std::min(alignSection(sizeof(header)), size);
+	return hashBytes(data + payloadOffset, size - payloadOffset, hash);
+}
+
+class SnapshotWriter
+{
+public:
+	SnapshotString string(std::string_view string) {
+		auto existingString = m_stringOffsets.find(string);
+		if (existingString != m_stringOffsets.end()) {
+			return { existingString->second, static_cast<uint32_t>(string.size()) };
+		}
+		uint32_t offset = static_cast<uint32_t>(m_stringPool.size());
+		m_stringPool.append(string);
+		//Keys have to point into the registry, the pool may reallocate
+		m_stringOffsets.emplace(string, offset);
+		return { offset, static_cast<uint32_t>(string.size()) };
+	}
+
+	SnapshotValue value(const RegistryValue& value) {
+		return { string(value.name), string(value.value), string(value.bitpos), string(value.alias), string(value.offset),
+				 string(value.comment), string(value.dir), string(value.extends), string(value.extnumber), value.nameSymbol, value.extendsSymbol };
+	}
+
+	SnapshotBlock block(const RegistryBlock& block) {
+		SnapshotBlock snapshotBlock = { string(block.name), string(block.number), string(block.requiresList), string(block.depends),
+										string(block.promotedTo), block.nameSymbol,
+										static_cast<uint32_t>(values.size()), static_cast<uint32_t>(block.values.size()),
+										static_cast<uint32_t>(types.size()), static_cast<uint32_t>(block.types.size()) };
+		for (auto& blockValue : block.values) {
+			values.push_back(value(blockValue));
+		}
+		types.insert(types.end(), block.types.begin(), block.types.end());
+		return snapshotBlock;
+	}
+
+	std::vector<SnapshotString> symbols, tags;
+	std::vector<SnapshotEnum> enums;
+	std::vector<SnapshotBlock> features, extensions;
+	std::vector<SnapshotValue> values;
+	std::vector<Symbol> types;
+
+	const std::string& stringPool() const { return m_stringPool; }
+private:
+	std::string m_stringPool;
+	std::unordered_map<std::string_view, uint32_t> m_stringOffsets;
+};
+
+template<typename T>
+void writeSection(std::string& buffer, const std::vector<T>& section) {
+	buffer.append(reinterpret_cast<const char*>(section.data()), section.size() * sizeof(T));
+	buffer.resize(alignSection(buffer.size()), '\0');
+}
+
+//Bounds-checked sequential access to the sections of a mapped snapshot
+class SnapshotReader
+{
+public:
+	SnapshotReader(const char* data, size_t size) : m_data(data), m_size(size) {}
+
+	//Returns a pointer to count elements of T at the current position and advances past them, nullptr if the file is too short
+	template<typename T>
+	const char* section(size_t count) {
+		size_t sectionSize = count * sizeof(T);
+		if (m_position > m_size || sectionSize > m_size - m_position) return nullptr;
+		const char* sectionData = m_data + m_position;
+		m_position = alignSection(m_position + sectionSize);
+		return sectionData;
+	}
+
+	template<typename T>
+	static T element(const char* section, size_t index) {
+		//The mapping is suitably aligned, but copying avoids relying on that
+		T element;
+		std::memcpy(&element, section + index * sizeof(T), sizeof(T));
+		return element;
+	}
+private:
+	const char* m_data;
+	size_t m_size;
+	size_t m_position = 0;
+};
+
+}
+
+bool saveRegistrySnapshot(const Registry& registry, uint64_t sourceHash, const std::string& path)
+{
+	SnapshotWriter writer;
+	for (Symbol symbol = 0; symbol < registry.symbols.size(); ++symbol) {
+		writer.symbols.push_back(writer.string(registry.symbols.string(symbol)));
+	}
+	for (auto& tag : registry.tags) {
+		writer.tags.push_back(writer.string(tag));
+	}
+	for (auto& registryEnum : registry.enums) {
+		writer.enums.push_back({ writer.string(registryEnum.name), writer.string(registryEnum.type), writer.string(registryEnum.bitwidth),
+								 registryEnum.nameSymbol, static_cast<uint32_t>(writer.values.size()), static_cast<uint32_t>(registryEnum.values.size()) });
+		for (auto& value : registryEnum.values) {
+			writer.values.push_back(writer.value(value));
+		}
+	}
+	for (auto& feature : registry.features) {
+		writer.features.push_back(writer.block(feature));
+	}
+	for (auto& extension : registry.extensions) {
+		writer.extensions.push_back(writer.block(extension));
+	}
+
+	SnapshotHeader header = {};
+	std::memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+	header.formatVersion = snapshotFormatVersion;
+	header.headerSize = sizeof(SnapshotHeader);
+	header.sourceHash = sourceHash;
+	header.symbolCount = static_cast<uint32_t>(writer.symbols.size());
+	header.tagCount = static_cast<uint32_t>(writer.tags.size());
+	header.enumCount = static_cast<uint32_t>(writer.enums.size());
+	header.featureCount = static_cast<uint32_t>(writer.features.size());
+	header.extensionCount = static_cast<uint32_t>(writer.extensions.size());
+	header.valueCount = static_cast<uint32_t>(writer.values.size());
+	header.typeCount = static_cast<uint32_t>(writer.types.size());
+	header.stringPoolSize = static_cast<uint32_t>(writer.stringPool().size());
+
+	std::string buffer;
+	buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+	buffer.resize(alignSection(buffer.size()), '\0');
+	writeSection(buffer, writer.symbols);
+	writeSection(buffer, writer.tags);
+	writeSection(buffer, writer.enums);
+	writeSection(buffer, writer.features);
+	writeSection(buffer, writer.extensions);
+	writeSection(buffer, writer.values);
+	writeSection(buffer, writer.types);
+	buffer.append(writer.stringPool());
+	header.checksum = snapshotChecksum(header, buffer.data(), buffer.size());
+	std::memcpy(buffer.data(), &header, sizeof(header));
+
+	//Write to a temporary file first, so concurrent generator runs never see a partial snapshot
+	std::string temporaryPath = path + ".tmp";
+	{
+		std::ofstream file = std::ofstream(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) return false;
+		file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		if (!file.good()) return false;
+	}
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, path, error);
+	return !error;
+}
+
+bool loadRegistrySnapshot(const std::string& path, uint64_t sourceHash, Registry& registry)
+{
+	if (!registry.source.open(path)) {
+		return false;
+	}
+
+	SnapshotReader reader = SnapshotReader(registry.source.data(), registry.source.size());
+	const char* headerData = reader.section<SnapshotHeader>(1);
+	if (!headerData) return false;
+	SnapshotHeader header = SnapshotReader::element<SnapshotHeader>(headerData, 0);
+	if (std::memcmp(header.magic, snapshotMagic, sizeof(snapshotMagic)) || header.formatVersion != snapshotFormatVersion ||
+		header.headerSize != sizeof(SnapshotHeader) || header.sourceHash != sourceHash) {
+		return false;
+	}
+	if (header.checksum != snapshotChecksum(header, registry.source.data(), registry.source.size())) {
+		std::cout << "Warning: The registry snapshot " << path << " is damaged, parsing vk.xml instead\n";
+		return false;
+	}
+
+	const char* symbols = reader.section<SnapshotString>(header.symbolCount);
+	const char* tags = reader.section<SnapshotString>(header.tagCount);
+	const char* enums = reader.section<SnapshotEnum>(header.enumCount);
+	const char* features = reader.section<SnapshotBlock>(header.featureCount);
+	const char* extensions = reader.section<SnapshotBlock>(header.extensionCount);
+	const char* values = reader.section<SnapshotValue>(header.valueCount);
+	const char* types = reader.section<Symbol>(header.typeCount);
+	const char* stringPool = reader.section<char>(header.stringPoolSize);
+	if (!symbols || !tags || !enums || !features || !extensions || !values || !types || !stringPool) {
+		return false;
+	}
+
+	bool isValid = true;
+	auto string = [&](SnapshotString string) {
+		if (string.offset > header.stringPoolSize || string.length > header.stringPoolSize - string.offset) {
+			isValid = false;
+			return std::string_view();
+		}
+		return std::string_view(stringPool + string.offset, string.length);
+	};
+	auto symbol = [&](Symbol symbol) {
+		if (symbol != invalidSymbol && symbol >= header.symbolCount) isValid = false;
+		return symbol;
+	};
+	auto value = [&](uint32_t index) {
+		SnapshotValue snapshotValue = SnapshotReader::element<SnapshotValue>(values, index);
+		return RegistryValue{ string(snapshotValue.name), string(snapshotValue.value), string(snapshotValue.bitpos), string(snapshotValue.alias),
+							  string(snapshotValue.offset), string(snapshotValue.comment), string(snapshotValue.dir), string(snapshotValue.extends),
+							  string(snapshotValue.extnumber), symbol(snapshotValue.nameSymbol), symbol(snapshotValue.extendsSymbol) };
+	};
+	auto readValues = [&](uint32_t firstValue, uint32_t valueCount, std::vector<RegistryValue>& blockValues) {
+		if (firstValue > header.valueCount || valueCount > header.valueCount - firstValue) {
+			isValid = false;
+			return;
+		}
+		blockValues.reserve(valueCount);
+		for (uint32_t i = firstValue; i < firstValue + valueCount; ++i) {
+			blockValues.push_back(value(i));
+		}
+	};
+	auto readBlocks = [&](const char* section, uint32_t count, std::vector<RegistryBlock>& blocks) {
+		blocks.resize(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			SnapshotBlock snapshotBlock = SnapshotReader::element<SnapshotBlock>(section, i);
+			RegistryBlock& block = blocks[i];
+			block.name = string(snapshotBlock.name);
+			block.number = string(snapshotBlock.number);
+			block.requiresList = string(snapshotBlock.requiresList);
+			block.depends = string(snapshotBlock.depends);
+			block.promotedTo = string(snapshotBlock.promotedTo);
+			block.nameSymbol = symbol(snapshotBlock.nameSymbol);
+			readValues(snapshotBlock.firstValue, snapshotBlock.valueCount, block.values);
+
+			if (snapshotBlock.firstType > header.typeCount || snapshotBlock.typeCount > header.typeCount - snapshotBlock.firstType) {
+				isValid = false;
+				continue;
+			}
+			block.types.reserve(snapshotBlock.typeCount);
+			for (uint32_t j = snapshotBlock.firstType; j < snapshotBlock.firstType + snapshotBlock.typeCount; ++j) {
+				block.types.push_back(symbol(SnapshotReader::element<Symbol>(types, j)));
+			}
+		}
+	};
+
+	//Interning in the original order reproduces the original symbols
+	for (uint32_t i = 0; i < header.symbolCount; ++i) {
+		if (registry.symbols.intern(string(SnapshotReader::element<SnapshotString>(symbols, i))) != i) {
+			return false;
+		}
+	}
+	registry.tags.reserve(header.tagCount);
+	for (uint32_t i = 0; i < header.tagCount; ++i) {
+		registry.tags.push_back(string(SnapshotReader::element<SnapshotString>(tags, i)));
+	}
+	registry.enums.resize(header.enumCount);
+	for (uint32_t i = 0; i < header.enumCount; ++i) {
+		SnapshotEnum snapshotEnum = SnapshotReader::element<SnapshotEnum>(enums, i);
+		RegistryEnum& registryEnum = registry.enums[i];
+		registryEnum.name = string(snapshotEnum.name);
+		registryEnum.type = string(snapshotEnum.type);
+		registryEnum.bitwidth = string(snapshotEnum.bitwidth);
+		registryEnum.nameSymbol = symbol(snapshotEnum.nameSymbol);
+		readValues(snapshotEnum.firstValue, snapshotEnum.valueCount, registryEnum.values);
+	}
+	readBlocks(features, header.featureCount, registry.features);
+	readBlocks(extensions, header.extensionCount, registry.extensions);
+	return isValid;
+}
@@ -0,0 +1,133 @@
+//VulkanEnumClasses v1.0
+//https://github.com/pixelcluster/VulkanEnumClasses
+
+#pragma once
+#include <vector>
+#include <string_view>
+#include <cstdint>
+
+//Interned strings. Every distinct name of the registry gets a dense integer id,
+//so lookups and de-duplication compare integers instead of strings.
+
+using Symbol = uint32_t;
+constexpr Symbol invalidSymbol = ~static_cast<Symbol>(0);
+
+//64-bit FNV-1a. Passing the result of a previous call as hash continues hashing as if the strings were concatenated.
+inline uint64_t hashString(std::string_view string, uint64_t hash = 14695981039346656037ULL) {
+	for (char character : string) {
+		hash ^= static_cast<unsigned char>(character);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+//Generator-wide string interner. Only views are stored, the strings must outlive the table.
+//Open addressing with linear probing, lookups don't allocate.
+class SymbolTable
+{
+public:
+	//Returns the symbol of string, assigning the next free one if it wasn't interned before
+	Symbol intern(std::string_view string) {
+		if ((m_strings.size() + 1) * 4 > m_slots.size() * 3) {
+			rehash(m_slots.empty() ? 1024 : m_slots.size() * 2);
+		}
+		uint64_t hash = hashString(string);
+		size_t mask = m_slots.size() - 1;
+		for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+			Symbol symbol = m_slots[slot];
+			if (symbol == invalidSymbol) {
+				symbol = static_cast<Symbol>(m_strings.size());
+				m_slots[slot] = symbol;
+				m_strings.push_back(string);
+				m_hashes.push_back(hash);
+				return symbol;
+			}
+			if (m_hashes[symbol] == hash && m_strings[symbol] == string) {
+				return symbol;
+			}
+		}
+	}
+
+	//Returns the symbol of string or invalidSymbol if it was never interned
+	Symbol find(std::string_view string) const {
+		if (m_slots.empty()) return invalidSymbol;
+		uint64_t hash = hashString(string);
+		size_t mask = m_slots.size() - 1;
+		for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+			Symbol symbol = m_slots[slot];
+			if (symbol == invalidSymbol || (m_hashes[symbol] == hash && m_strings[symbol] == string)) {
+				return symbol;
+			}
+		}
+	}
+
+	std::string_view string(Symbol symbol) const { return m_strings[symbol]; }
+	size_t size() const { return m_strings.size(); }
+private:
+	std::vector<std::string_view> m_strings;
+	std::vector<uint64_t> m_hashes;
+	//Power-of-two sized, contains symbols or invalidSymbol for empty slots
+	std::vector<Symbol> m_slots;
+
+	void rehash(size_t slotCount) {
+		m_slots.assign(slotCount, invalidSymbol);
+		size_t mask = slotCount - 1;
+		for (Symbol symbol = 0; symbol < m_strings.size(); ++symbol) {
+			size_t slot = m_hashes[symbol] & mask;
+			while (m_slots[slot] != invalidSymbol) slot = (slot + 1) & mask;
+			m_slots[slot] = symbol;
+		}
+	}
+};
+
+//Compact open-addressing set of symbols
+class SymbolSet
+{
+public:
+	//Returns true if symbol wasn't part of the set before
+	bool insert(Symbol symbol) {
+		if ((m_count + 1) * 4 > m_slots.size() * 3) {
+			rehash(m_slots.empty() ? 8 : m_slots.size() * 2);
+		}
+		size_t mask = m_slots.size() - 1;
+		for (size_t slot = slotOf(symbol); ; slot = (slot + 1) & mask) {
+			if (m_slots[slot] == symbol) return false;
+			if (m_slots[slot] == invalidSymbol) {
+				m_slots[slot] = symbol;
+				++m_count;
+				return true;
+			}
+		}
+	}
+
+	bool contains(Symbol symbol) const {
+		if (m_slots.empty()) return false;
+		size_t mask = m_slots.size() - 1;
+		for (size_t slot = slotOf(symbol); ; slot = (slot + 1) & mask) {
+			if (m_slots[slot] == symbol) return true;
+			if (m_slots[slot] == invalidSymbol) return false;
+		}
+	}
+
+	size_t size() const { return m_count; }
+private:
+	std::vector<Symbol> m_slots;
+	size_t m_count = 0;
+	unsigned int m_shift = 64;
+
+	//Fibonacci hashing, symbols are sequential so their low bits alone would cluster
+	size_t slotOf(Symbol symbol) const {
+		return static_cast<size_t>((symbol * 11400714819323198485ULL) >> m_shift);
+	}
+
+	void rehash(size_t slotCount) {
+		std::vector<Symbol> oldSlots = std::move(m_slots);
+		m_slots.assign(slotCount, invalidSymbol);
+		m_shift = 64;
+		for (size_t count = slotCount; count > 1; count >>= 1) --m_shift;
+		m_count = 0;
+		for (Symbol symbol : oldSlots) {
+			if (symbol != invalidSymbol) insert(symbol);
+		}
+	}
+};
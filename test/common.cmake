@@ -0,0 +1,45 @@
+#VulkanEnumClasses v1.0
+#https://github.com/pixelcluster/VulkanEnumClasses
+
+#Helpers shared by the generator tests. GENERATOR and XMLPATH have to be set.
+set(NAMING_ARGUMENTS --replace-names --replace-values --value-number-prefix _ --remove-underscores --remove-structure-names --tolower
+	--capitalize-start --value-remove-postfix)
+
+#Runs the generator with the given arguments in directory, which is created if it doesn't exist. Its output is stored in GENERATOR_OUTPUT.
+function(runGenerator directory)
+	file(MAKE_DIRECTORY "${directory}")
+	execute_process(COMMAND "${GENERATOR}" --path "${XMLPATH}" ${ARGN}
+		WORKING_DIRECTORY "${directory}" RESULT_VARIABLE result OUTPUT_VARIABLE output ERROR_VARIABLE output)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "The generator failed in ${directory} (${result}):\n${output}")
+	endif()
+	set(GENERATOR_OUTPUT "${output}" PARENT_SCOPE)
+endfunction()
+
+#Runs the generator with the given arguments in a new, empty directory
+function(generate directory)
+	file(REMOVE_RECURSE "${directory}")
+	runGenerator("${directory}" ${ARGN})
+endfunction()
+
+#Fails if the generated files in directory aren't the same as the ones in referenceDirectory. Stamps aren't generated code.
+function(compareDirectories referenceDirectory directory)
+	file(GLOB_RECURSE referenceFiles LIST_DIRECTORIES false RELATIVE "${referenceDirectory}" "${referenceDirectory}/*")
+	file(GLOB_RECURSE files LIST_DIRECTORIES false RELATIVE "${directory}" "${directory}/*")
+	list(FILTER referenceFiles EXCLUDE REGEX "\\.stamp$")
+	list(FILTER files EXCLUDE REGEX "\\.stamp$")
+	list(SORT referenceFiles)
+	list(SORT files)
+	if(NOT referenceFiles)
+		message(FATAL_ERROR "The generator wrote no files to ${referenceDirectory}")
+	endif()
+	if(NOT referenceFiles STREQUAL files)
+		message(FATAL_ERROR "${directory} contains different files than ${referenceDirectory}:\n${files}\n${referenceFiles}")
+	endif()
+	foreach(file IN LISTS files)
+		execute_process(COMMAND "${CMAKE_COMMAND}" -E compare_files "${referenceDirectory}/${file}" "${directory}/${file}" RESULT_VARIABLE result)
+		if(NOT result EQUAL 0)
+			message(FATAL_ERROR "${directory}/${file} differs from ${referenceDirectory}/${file}")
+		endif()
+	endforeach()
+endfunction()
@@ -0,0 +1,34 @@
+#VulkanEnumClasses v1.0
+#https://github.com/pixelcluster/VulkanEnumClasses
+
+#Generates the same files with one and several threads, with the streaming and the DOM registry reader and from a registry snapshot.
+#Fails if any of the results differs from the single-threaded streaming one in a single byte.
+#Arguments (-D): GENERATOR, XMLPATH, BINARY_DIR, JOBS
+include("${CMAKE_CURRENT_LIST_DIR}/common.cmake")
+
+#Every optional function, so the order of the tables and hash seeds they depend on is compared as well
+set(FUNCTION_ARGUMENTS --to-string --from-string --bit-helpers --reflection --dense-index --validation --bulk-operations --hash --flat-map
+	--vk-interop)
+
+foreach(variant header split)
+	if(variant STREQUAL "header")
+		set(arguments --namespace vk ${NAMING_ARGUMENTS} ${FUNCTION_ARGUMENTS})
+	else()
+		set(arguments --split-output --module --sort-enums ${NAMING_ARGUMENTS} ${FUNCTION_ARGUMENTS})
+	endif()
+
+	set(variantDirectory "${BINARY_DIR}/${variant}")
+	generate("${variantDirectory}/reference" ${arguments} --jobs 1)
+	generate("${variantDirectory}/jobs" ${arguments} --jobs ${JOBS})
+	generate("${variantDirectory}/dom" ${arguments} --dom --jobs 1)
+	generate("${variantDirectory}/dom_jobs" ${arguments} --dom --jobs ${JOBS})
+	#The first run writes the snapshot, the second one reads the registry from it
+	file(REMOVE "${variantDirectory}/registry.snapshot")
+	generate("${variantDirectory}/snapshot" ${arguments} --snapshot "${variantDirectory}/registry.snapshot")
+	generate("${variantDirectory}/snapshot" ${arguments} --snapshot "${variantDirectory}/registry.snapshot")
+
+	foreach(directory jobs dom dom_jobs snapshot)
+		compareDirectories("${variantDirectory}/reference" "${variantDirectory}/${directory}")
+	endforeach()
+	message(STATUS "${variant}: identical with --jobs 1 and ${JOBS}, the streaming and the DOM reader and a registry snapshot")
+endforeach()
@@ -0,0 +1,29 @@
+#VulkanEnumClasses v1.0
+#https://github.com/pixelcluster/VulkanEnumClasses
+
+#Checks that a run with unchanged inputs skips generation, that it still regenerates files deleted since the last run,
+#and that split headers of an earlier configuration are removed.
+#Arguments (-D): GENERATOR, XMLPATH, BINARY_DIR
+include("${CMAKE_CURRENT_LIST_DIR}/common.cmake")
+
+set(arguments --split-output --module ${NAMING_ARGUMENTS})
+set(directory "${BINARY_DIR}/output")
+generate("${directory}" ${arguments})
+generate("${BINARY_DIR}/reference" ${arguments})
+
+runGenerator("${directory}" ${arguments})
+if(NOT GENERATOR_OUTPUT MATCHES "is up to date")
+	message(FATAL_ERROR "A run with unchanged inputs generated the files again:\n${GENERATOR_OUTPUT}")
+endif()
+
+file(GLOB groupHeaders "${directory}/VulkanEnums/*.hpp")
+list(GET groupHeaders 0 groupHeader)
+file(REMOVE "${directory}/VulkanEnumsFwd.hpp" "${groupHeader}" "${directory}/VulkanEnums.cppm")
+runGenerator("${directory}" ${arguments})
+compareDirectories("${BINARY_DIR}/reference" "${directory}")
+
+#Without extensions, the headers of all extensions have to disappear
+runGenerator("${directory}" ${arguments} --exclude-extensions)
+generate("${BINARY_DIR}/reference" ${arguments} --exclude-extensions)
+compareDirectories("${BINARY_DIR}/reference" "${directory}")
+message(STATUS "Deleted files are regenerated and stale split headers are removed")